@@ -0,0 +1,300 @@
+#include <JuceHeader.h>
+#include "MidiEventQueue.h"
+#include "NoteEvent.h"
+#include "NotePool.h"
+#include "FadeEngine.h"
+#include "NoteRenderer.h"
+#include "LatencyHistogram.h"
+#include "SyntheticMidiSource.h"
+#include "AllocationTracker.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Headless benchmark for the note pipeline. Each configuration runs a simulated
+// 60 Hz session: MIDI messages go through a MidiEventQueue and are ingested into a
+// NotePool the way MainComponent does it, the fade clock advances, and every frame
+// is rendered by NoteRenderer into an offscreen juce::Image. One JSON object per
+// configuration is written to stdout (or --output), one per line.
+//
+//   iLumidiBenchmark [--quick] [--frames N] [--seed N] [--pattern name] [--devices N]
+//                    [--output results.jsonl] [--check-allocations]
+//
+// This target is built with ILUMIDI_TRACK_ALLOCATIONS=1. --check-allocations exits
+// with status 1 if the queue handoff or any measured frame allocated outside the
+// rasteriser stage, or if the tracker can't see malloc/realloc on this platform
+// (AllocationTracker::runSelfCheck).
+//
+// Input comes from SyntheticMidiGenerator, so a given seed and pattern always
+// feed exactly the same messages.
+
+//==============================================================================
+namespace
+{
+    constexpr double frameSeconds = 1.0 / 60.0;
+    constexpr int warmUpFrames = 30;
+
+    struct Config
+    {
+        int notesPerSecond;
+        int liveNotes;      // pool capacity; the pool starts full
+        int width, height;
+        float fadeRate;     // percent per 1/60 s, 0 holds
+        FadeEngine::Shape fadeShape;
+        SyntheticMidiGenerator::Pattern pattern;
+        int numDevices;
+    };
+
+    struct Result
+    {
+        double nsPerEvent = 0.0;
+        double msPerFrameMean = 0.0;
+        double msPerFrameP99 = 0.0;
+        double msPerFrameMax = 0.0;
+        double meanLiveNotes = 0.0;
+        double allocationsPerFrame = 0.0;
+        juce::uint64 midiCallbackAllocations = 0;
+        juce::uint64 eventsIngested = 0;
+    };
+
+    double ticksToMs(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+    }
+
+    juce::uint64 getFrameAllocationCount()
+    {
+        return AllocationTracker::getCount(AllocationTracker::Stage::ingestion)
+             + AllocationTracker::getCount(AllocationTracker::Stage::animation)
+             + AllocationTracker::getCount(AllocationTracker::Stage::render);
+    }
+
+    //==============================================================================
+    Result run(const Config& config, int numFrames, juce::int64 seed)
+    {
+        SyntheticMidiGenerator::Settings input;
+        input.pattern = config.pattern;
+        input.eventsPerSecond = config.notesPerSecond;
+        input.numDevices = config.numDevices;
+        input.seed = seed;
+        SyntheticMidiGenerator generator(input);
+
+        // One queue per device, as with real inputs
+        std::vector<std::unique_ptr<MidiEventQueue>> queues;
+        for (int i = 0; i < config.numDevices; ++i)
+            queues.push_back(std::make_unique<MidiEventQueue>());
+
+        NotePool notes(config.liveNotes);
+        FadeEngine fade;
+        fade.setFadeRate(config.fadeRate);
+        fade.setShape(config.fadeShape);
+
+        NoteRenderer renderer;
+        renderer.setCanvasSize(config.width, config.height);
+
+        juce::Image canvas(juce::Image::ARGB, config.width, config.height, true);
+        juce::Graphics g(canvas);
+
+        // Start with a full pool so the renderer sees the requested note count from frame one
+        juce::Random random(seed);
+        for (int i = 0; i < config.liveNotes; ++i)
+        {
+            MidiEvent event;
+            event.size = 3;
+            event.data[0] = 0x90;
+            event.data[1] = static_cast<juce::uint8>(random.nextInt(128));
+            event.data[2] = static_cast<juce::uint8>(random.nextInt(127) + 1);
+
+            NoteEvent note;
+            if (NoteEvent::fromMidiEvent(event, 0, fade.getCurrentPhase(), note))
+                notes.add(note);
+        }
+
+        Result result;
+        LatencyHistogram frameMicros;
+        juce::int64 ingestTicks = 0, frameTicks = 0;
+        juce::uint64 eventsIngested = 0, allocationsMeasured = 0;
+        double liveNotesTotal = 0.0;
+
+        for (int frame = 0; frame < warmUpFrames + numFrames; ++frame)
+        {
+            auto measuring = frame >= warmUpFrames;
+            auto allocationsBefore = getFrameAllocationCount();
+            auto frameStart = juce::Time::getHighResolutionTicks();
+
+            // The MIDI thread's side of the handoff; not part of ns/event
+            auto midiCallbackBefore = AllocationTracker::getCount(AllocationTracker::Stage::midiCallback);
+            generator.generateUntil((frame + 1) * frameSeconds, 0.0, [&queues](int device, const juce::MidiMessage& message) {
+                AllocationTracker::ScopedStage stage(AllocationTracker::Stage::midiCallback);
+                queues[static_cast<size_t>(device)]->push(message);
+            });
+            auto midiCallbackAllocations = AllocationTracker::getCount(AllocationTracker::Stage::midiCallback) - midiCallbackBefore;
+
+            // Ingestion as in MainComponent::processMidiMessage: drain, decode, pool insert
+            auto ingestStart = juce::Time::getHighResolutionTicks();
+            int ingested = 0;
+            for (int device = 0; device < config.numDevices; ++device)
+            {
+                AllocationTracker::ScopedStage stage(AllocationTracker::Stage::ingestion);
+                ingested += queues[static_cast<size_t>(device)]->drain([&](const MidiEvent& event)
+                {
+                    NoteEvent note;
+                    if (NoteEvent::fromMidiEvent(event, device, fade.getCurrentPhase(), note))
+                        notes.add(note);
+                });
+            }
+            auto ingestEnd = juce::Time::getHighResolutionTicks();
+
+            // Animation and a full-canvas frame, as after a full repaint()
+            {
+                AllocationTracker::ScopedStage stage(AllocationTracker::Stage::animation);
+
+                if (fade.advance(frameSeconds))
+                    notes.clear();
+
+                notes.removeExpired([&fade](const NoteEvent& note) { return fade.isExpired(note); });
+            }
+
+            {
+                AllocationTracker::ScopedStage stage(AllocationTracker::Stage::render);
+                renderer.batchNotes(canvas.getBounds(), notes, fade);
+            }
+
+            // The software renderer allocates edge tables per fill; that's JUCE's, not a frame violation
+            {
+                AllocationTracker::ScopedStage stage(AllocationTracker::Stage::rasteriser);
+                g.fillAll(juce::Colours::black);
+                renderer.fillBatches(g, juce::Colours::white);
+            }
+
+            auto frameEnd = juce::Time::getHighResolutionTicks();
+            auto frameAllocations = getFrameAllocationCount() - allocationsBefore;
+
+            if (measuring)
+            {
+                frameMicros.record(static_cast<juce::uint32>(ticksToMs(frameEnd - frameStart) * 1000.0));
+                frameTicks += frameEnd - frameStart;
+                ingestTicks += ingestEnd - ingestStart;
+                eventsIngested += static_cast<juce::uint64>(ingested);
+                allocationsMeasured += frameAllocations;
+                result.midiCallbackAllocations += midiCallbackAllocations;
+                liveNotesTotal += notes.size();
+            }
+        }
+
+        result.eventsIngested = eventsIngested;
+        result.nsPerEvent = eventsIngested > 0 ? ticksToMs(ingestTicks) * 1.0e6 / static_cast<double>(eventsIngested) : 0.0;
+        result.msPerFrameMean = ticksToMs(frameTicks) / numFrames;
+        result.msPerFrameP99 = frameMicros.getPercentile(99.0) * 0.001;
+        result.msPerFrameMax = frameMicros.getMax() * 0.001;
+        result.meanLiveNotes = liveNotesTotal / numFrames;
+        result.allocationsPerFrame = static_cast<double>(allocationsMeasured) / numFrames;
+
+        return result;
+    }
+
+    //==============================================================================
+    juce::String toJson(const Config& config, const Result& result, int numFrames, juce::int64 seed)
+    {
+        auto shape = config.fadeShape == FadeEngine::Shape::exponential ? "exponential" : "linear";
+
+        return "{\"notesPerSecond\":" + juce::String(config.notesPerSecond)
+             + ",\"liveNotes\":" + juce::String(config.liveNotes)
+             + ",\"width\":" + juce::String(config.width)
+             + ",\"height\":" + juce::String(config.height)
+             + ",\"fadeRate\":" + juce::String(config.fadeRate, 2)
+             + ",\"fadeShape\":\"" + shape + "\""
+             + ",\"pattern\":\"" + SyntheticMidiGenerator::getPatternName(config.pattern) + "\""
+             + ",\"devices\":" + juce::String(config.numDevices)
+             + ",\"frames\":" + juce::String(numFrames)
+             + ",\"seed\":" + juce::String(seed)
+             + ",\"eventsIngested\":" + juce::String(result.eventsIngested)
+             + ",\"nsPerEvent\":" + juce::String(result.nsPerEvent, 1)
+             + ",\"msPerFrameMean\":" + juce::String(result.msPerFrameMean, 3)
+             + ",\"msPerFrameP99\":" + juce::String(result.msPerFrameP99, 3)
+             + ",\"msPerFrameMax\":" + juce::String(result.msPerFrameMax, 3)
+             + ",\"meanLiveNotes\":" + juce::String(result.meanLiveNotes, 1)
+             + ",\"allocationsPerFrame\":" + juce::String(result.allocationsPerFrame, 2)
+             + ",\"midiCallbackAllocations\":" + juce::String(result.midiCallbackAllocations)
+             + "}";
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    auto quick = args.containsOption("--quick");
+    auto checkAllocations = args.containsOption("--check-allocations");
+    auto allocationCheckFailed = checkAllocations && !AllocationTracker::runSelfCheck();
+    auto numFrames = args.containsOption("--frames") ? juce::jmax(1, args.getValueForOption("--frames").getIntValue()) : (quick ? 60 : 300);
+    auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : 1;
+    auto pattern = SyntheticMidiGenerator::getPatternFromName(args.getValueForOption("--pattern"));
+    auto numDevices = args.containsOption("--devices")
+                          ? juce::jlimit(1, SyntheticMidiGenerator::maxDevices, args.getValueForOption("--devices").getIntValue())
+                          : 1;
+
+    // Full sweep: every combination. --quick keeps the middle of each axis.
+    juce::Array<int> rates { 1000, 10000, 100000 };
+    juce::Array<int> liveNoteCounts { 1000, 8192, 65536 };
+    juce::Array<juce::Point<int>> resolutions { { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+    juce::Array<std::pair<float, FadeEngine::Shape>> fades { { 5.0f, FadeEngine::Shape::exponential },
+                                                             { 5.0f, FadeEngine::Shape::linear },
+                                                             { 0.0f, FadeEngine::Shape::exponential } };
+
+    if (quick)
+    {
+        rates = { 10000 };
+        liveNoteCounts = { 8192 };
+        resolutions = { { 1920, 1080 } };
+        fades.removeRange(1, 2);
+    }
+
+    std::unique_ptr<juce::FileOutputStream> file;
+    if (args.containsOption("--output"))
+    {
+        juce::File outputFile(juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output")));
+        outputFile.deleteFile();
+        file = std::make_unique<juce::FileOutputStream>(outputFile);
+
+        if (!file->openedOk())
+        {
+            std::cerr << "Can't write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    for (auto rate : rates)
+        for (auto liveNotes : liveNoteCounts)
+            for (auto resolution : resolutions)
+                for (auto fade : fades)
+                {
+                    Config config { rate, liveNotes, resolution.x, resolution.y, fade.first, fade.second, pattern, numDevices };
+                    auto result = run(config, numFrames, seed);
+                    auto line = toJson(config, result, numFrames, seed);
+
+                    if (result.allocationsPerFrame > 0.0 || result.midiCallbackAllocations > 0)
+                        allocationCheckFailed = true;
+
+                    if (file != nullptr)
+                        *file << line << "\n";
+
+                    std::cout << line << std::endl;
+                }
+
+    if (checkAllocations)
+    {
+        std::cerr << AllocationTracker::getReport() << std::endl;
+
+        if (allocationCheckFailed)
+        {
+            std::cerr << "Allocation check FAILED: the tracker self-check failed, or the queue handoff or a steady-state frame allocated" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include "AllocationTracker.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+#if ILUMIDI_TRACK_ALLOCATIONS
+ #if JUCE_MAC
+  #include <malloc/malloc.h>
+  #include <mach/mach.h>
+  #include <pthread.h>
+ #elif JUCE_LINUX && defined(__GLIBC__)
+  extern "C" void* __libc_malloc(size_t);
+  extern "C" void* __libc_calloc(size_t, size_t);
+  extern "C" void* __libc_realloc(void*, size_t);
+  extern "C" void __libc_free(void*);
+ #elif JUCE_WINDOWS
+  #include <malloc.h>
+ #endif
+#endif
+
+//==============================================================================
+namespace
+{
+    std::array<std::atomic<juce::uint64>, AllocationTracker::numStages> countsByStage {};
+    std::array<std::atomic<juce::uint64>, AllocationTracker::maxThreads> countsByThread {};
+    std::array<std::atomic<juce::Thread::ThreadID>, AllocationTracker::maxThreads> threadIds {};
+    std::atomic<int> numThreadsRegistered { 0 };
+    std::atomic<juce::uint64> numOverflowThreadAllocations { 0 };
+
+    std::atomic<bool> realtimeCheckArmed { false };
+    std::atomic<juce::uint64> numRealtimeViolations { 0 };
+    std::atomic<int> firstViolationStage { 0 };
+
+    // Set during static init if the malloc zone couldn't be made writable (macOS)
+    bool mallocHookFailed = false;
+
+   #if JUCE_MAC && ILUMIDI_TRACK_ALLOCATIONS
+    // On macOS a thread_local's first access in a thread can itself call malloc,
+    // which would recurse into the zone hook below; pthread TSD slots never allocate
+    pthread_key_t stageKey, threadIndexKey;
+
+    AllocationTracker::Stage getCurrentStage() noexcept    { return static_cast<AllocationTracker::Stage>(reinterpret_cast<std::uintptr_t>(pthread_getspecific(stageKey))); }
+    void setCurrentStage(AllocationTracker::Stage stage)    { pthread_setspecific(stageKey, reinterpret_cast<void*>(static_cast<std::uintptr_t>(stage))); }
+    int getThreadIndex() noexcept                           { return static_cast<int>(reinterpret_cast<std::intptr_t>(pthread_getspecific(threadIndexKey))) - 1; }
+    void setThreadIndex(int index)                          { pthread_setspecific(threadIndexKey, reinterpret_cast<void*>(static_cast<std::intptr_t>(index + 1))); }
+   #else
+    // Plain thread_locals: no constructors, so reading them can't allocate
+    thread_local AllocationTracker::Stage currentStage = AllocationTracker::Stage::untracked;
+    thread_local int threadIndex = -1;
+
+    AllocationTracker::Stage getCurrentStage() noexcept    { return currentStage; }
+    void setCurrentStage(AllocationTracker::Stage stage)    { currentStage = stage; }
+    int getThreadIndex() noexcept                           { return threadIndex; }
+    void setThreadIndex(int index)                          { threadIndex = index; }
+   #endif
+}
+
+//==============================================================================
+AllocationTracker::Stage AllocationTracker::enterStage(Stage stage) noexcept
+{
+    auto previous = getCurrentStage();
+    setCurrentStage(stage);
+    return previous;
+}
+
+void AllocationTracker::noteAllocation() noexcept
+{
+    auto stage = getCurrentStage();
+    countsByStage[static_cast<size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+
+    auto threadIndex = getThreadIndex();
+    if (threadIndex < 0)
+    {
+        threadIndex = juce::jmin(numThreadsRegistered.fetch_add(1, std::memory_order_relaxed), maxThreads);
+        setThreadIndex(threadIndex);
+
+        if (threadIndex < maxThreads)
+            threadIds[static_cast<size_t>(threadIndex)].store(juce::Thread::getCurrentThreadId(), std::memory_order_relaxed);
+    }
+
+    if (threadIndex < maxThreads)
+        countsByThread[static_cast<size_t>(threadIndex)].fetch_add(1, std::memory_order_relaxed);
+    else
+        numOverflowThreadAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (isRealtime(stage) && realtimeCheckArmed.load(std::memory_order_relaxed))
+    {
+        if (numRealtimeViolations.fetch_add(1, std::memory_order_relaxed) == 0)
+            firstViolationStage.store(static_cast<int>(stage), std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+juce::uint64 AllocationTracker::getCount(Stage stage) noexcept
+{
+    return countsByStage[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+}
+
+juce::uint64 AllocationTracker::getTotalCount() noexcept
+{
+    juce::uint64 total = 0;
+    for (auto& count : countsByStage)
+        total += count.load(std::memory_order_relaxed);
+    return total;
+}
+
+void AllocationTracker::setRealtimeCheckArmed(bool shouldBeArmed) noexcept
+{
+    if (shouldBeArmed)
+    {
+        numRealtimeViolations.store(0, std::memory_order_relaxed);
+        firstViolationStage.store(0, std::memory_order_relaxed);
+    }
+
+    realtimeCheckArmed.store(shouldBeArmed, std::memory_order_relaxed);
+}
+
+juce::uint64 AllocationTracker::getNumRealtimeViolations() noexcept
+{
+    return numRealtimeViolations.load(std::memory_order_relaxed);
+}
+
+AllocationTracker::Stage AllocationTracker::getFirstViolationStage() noexcept
+{
+    return static_cast<Stage>(firstViolationStage.load(std::memory_order_relaxed));
+}
+
+//==============================================================================
+const char* AllocationTracker::getStageName(Stage stage) noexcept
+{
+    switch (stage)
+    {
+        case Stage::untracked:      return "untracked";
+        case Stage::midiCallback:   return "MIDI callback";
+        case Stage::ingestion:      return "ingestion";
+        case Stage::animation:      return "animation";
+        case Stage::render:         return "render";
+        case Stage::rasteriser:     return "rasteriser";
+        case Stage::numStages:      break;
+    }
+
+    return "?";
+}
+
+juce::String AllocationTracker::getReport()
+{
+    if (!isEnabled)
+        return "Allocation tracking is not compiled in (ILUMIDI_TRACK_ALLOCATIONS=0)";
+
+    juce::String report;
+
+    for (int i = 0; i < numStages; ++i)
+        report << "stage " << getStageName(static_cast<Stage>(i)) << ": " << juce::String(getCount(static_cast<Stage>(i))) << "\n";
+
+    auto numThreads = juce::jmin(numThreadsRegistered.load(std::memory_order_relaxed), maxThreads);
+    for (int i = 0; i < numThreads; ++i)
+        report << "thread 0x" << juce::String::toHexString(static_cast<juce::int64>(reinterpret_cast<juce::pointer_sized_int>(threadIds[static_cast<size_t>(i)].load())))
+               << ": " << juce::String(countsByThread[static_cast<size_t>(i)].load(std::memory_order_relaxed)) << "\n";
+
+    if (auto overflow = numOverflowThreadAllocations.load(std::memory_order_relaxed))
+        report << "other threads: " << juce::String(overflow) << "\n";
+
+    report << "realtime violations: " << juce::String(getNumRealtimeViolations());
+    if (getNumRealtimeViolations() > 0)
+        report << " (first in " << getStageName(getFirstViolationStage()) << ")";
+
+    return report;
+}
+
+//==============================================================================
+bool AllocationTracker::runSelfCheck()
+{
+    if (!isEnabled)
+        return false;
+
+    if (mallocHookFailed)
+    {
+        juce::Logger::writeToLog("AllocationTracker self-check FAILED: the default malloc zone couldn't be hooked, so allocation tracking is unavailable");
+        return false;
+    }
+
+    // Array and Path grow through HeapBlock, i.e. malloc/realloc rather than operator new
+    auto before = getCount(Stage::render);
+
+    {
+        ScopedStage stage(Stage::render);
+
+        juce::Array<int> array;
+        array.add(1);
+
+        juce::Path path;
+        for (int i = 0; i < 64; ++i)
+            path.addRectangle(static_cast<float>(i), 0.0f, 1.0f, 1.0f);
+    }
+
+    auto seen = getCount(Stage::render) - before;
+    if (seen >= 2)
+        return true;
+
+    juce::Logger::writeToLog("AllocationTracker self-check FAILED: growing a juce::Array and juce::Path counted "
+                             + juce::String(seen) + " allocation(s); malloc/realloc aren't being tracked on this platform");
+    return false;
+}
+
+//==============================================================================
+#if ILUMIDI_TRACK_ALLOCATIONS
+
+// JUCE containers, paths and edge tables allocate through HeapBlock, which calls
+// std::malloc/std::realloc directly, so counting operator new alone would miss
+// them. Where the C allocator can be hooked it is counted instead, and operator
+// new just forwards to it; elsewhere (Windows) only operator new is counted and
+// runSelfCheck() reports the gap.
+#if JUCE_MAC
+
+namespace
+{
+    void* (*zoneMalloc)(malloc_zone_t*, size_t);
+    void* (*zoneCalloc)(malloc_zone_t*, size_t, size_t);
+    void* (*zoneRealloc)(malloc_zone_t*, void*, size_t);
+
+    void* countingMalloc(malloc_zone_t* zone, size_t size)              { AllocationTracker::noteAllocation(); return zoneMalloc(zone, size); }
+    void* countingCalloc(malloc_zone_t* zone, size_t n, size_t size)    { AllocationTracker::noteAllocation(); return zoneCalloc(zone, n, size); }
+    void* countingRealloc(malloc_zone_t* zone, void* p, size_t size)    { AllocationTracker::noteAllocation(); return zoneRealloc(zone, p, size); }
+
+    // Swaps the default malloc zone's entry points at static init time. If the
+    // zone can't be made writable it's left alone, and runSelfCheck() says so.
+    struct ZoneHook
+    {
+        ZoneHook()
+        {
+            pthread_key_create(&stageKey, nullptr);
+            pthread_key_create(&threadIndexKey, nullptr);
+
+            auto* zone = malloc_default_zone();
+            auto address = reinterpret_cast<vm_address_t>(zone);
+            if (vm_protect(mach_task_self(), address, sizeof(malloc_zone_t), 0, VM_PROT_READ | VM_PROT_WRITE) != KERN_SUCCESS)
+            {
+                mallocHookFailed = true;
+                return;
+            }
+
+            zoneMalloc = zone->malloc;
+            zoneCalloc = zone->calloc;
+            zoneRealloc = zone->realloc;
+            zone->malloc = countingMalloc;
+            zone->calloc = countingCalloc;
+            zone->realloc = countingRealloc;
+
+            vm_protect(mach_task_self(), address, sizeof(malloc_zone_t), 0, VM_PROT_READ);
+        }
+    };
+
+    const ZoneHook zoneHook;
+}
+
+constexpr bool operatorNewCounts = false;
+
+#elif JUCE_LINUX && defined(__GLIBC__)
+
+// Defining these in the executable replaces glibc's; they forward to the real allocator
+extern "C" void* malloc(size_t size) noexcept             { AllocationTracker::noteAllocation(); return __libc_malloc(size); }
+extern "C" void* calloc(size_t n, size_t size) noexcept   { AllocationTracker::noteAllocation(); return __libc_calloc(n, size); }
+extern "C" void* realloc(void* p, size_t size) noexcept   { AllocationTracker::noteAllocation(); return __libc_realloc(p, size); }
+extern "C" void free(void* p) noexcept                    { __libc_free(p); }
+
+constexpr bool operatorNewCounts = false;
+
+#else
+
+constexpr bool operatorNewCounts = true;
+
+#endif
+
+void* operator new(std::size_t size)
+{
+    if (operatorNewCounts)
+        AllocationTracker::noteAllocation();
+
+    if (auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Over-aligned types; aligned allocation bypasses the malloc hooks, so it's always counted here
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    AllocationTracker::noteAllocation();
+
+    auto align = static_cast<std::size_t>(alignment);
+    auto rounded = (juce::jmax(size, static_cast<std::size_t>(1)) + align - 1) & ~(align - 1);
+
+   #if JUCE_WINDOWS
+    if (auto* p = _aligned_malloc(rounded, align))
+   #else
+    if (auto* p = std::aligned_alloc(align, rounded))
+   #endif
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+#if JUCE_WINDOWS
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+#else
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept { operator delete(p, alignment); }
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept { operator delete(p, alignment); }
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept { operator delete(p, alignment); }
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Build with ILUMIDI_TRACK_ALLOCATIONS=1 to replace the global operator new and
+// hook malloc/calloc/realloc (macOS malloc zone, glibc on Linux) and count every
+// heap allocation. Off by default; the stage markers then compile away.
+#ifndef ILUMIDI_TRACK_ALLOCATIONS
+ #define ILUMIDI_TRACK_ALLOCATIONS 0
+#endif
+
+//==============================================================================
+// Opt-in heap allocation counters, per thread and per pipeline stage. Code marks
+// the stage it's in with a ScopedStage; the replaced operator new attributes each
+// allocation to the calling thread and that thread's current stage. Counting is a
+// few relaxed atomic increments and never allocates itself.
+//
+// For the realtime check, arm it once the pipeline has warmed up: from then on
+// any allocation in a realtime stage counts as a violation.
+class AllocationTracker
+{
+public:
+    enum class Stage : juce::uint8
+    {
+        untracked,
+        midiCallback,   // MIDI input thread, from arrival to queue handoff
+        ingestion,      // draining the queues into the note pool
+        animation,      // fade clock and expiry
+        render,         // paint(): note batching and geometry
+        rasteriser,     // fills inside JUCE's renderer or the OS graphics backend; counted, never a violation
+        numStages
+    };
+
+    static constexpr bool isEnabled = ILUMIDI_TRACK_ALLOCATIONS != 0;
+    static constexpr int numStages = static_cast<int>(Stage::numStages);
+    static constexpr int maxThreads = 16;
+
+    class ScopedStage
+    {
+    public:
+       #if ILUMIDI_TRACK_ALLOCATIONS
+        explicit ScopedStage(Stage stage) noexcept : previous(enterStage(stage)) {}
+        ~ScopedStage() noexcept { enterStage(previous); }
+
+    private:
+        Stage previous;
+       #else
+        explicit ScopedStage(Stage) noexcept {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    static juce::uint64 getCount(Stage stage) noexcept;
+    static juce::uint64 getTotalCount() noexcept;
+
+    // Realtime stages are everything except 'untracked' and 'rasteriser'
+    static bool isRealtime(Stage stage) noexcept { return stage != Stage::untracked && stage != Stage::rasteriser; }
+    static void setRealtimeCheckArmed(bool shouldBeArmed) noexcept;
+    static juce::uint64 getNumRealtimeViolations() noexcept;
+    static Stage getFirstViolationStage() noexcept;
+
+    // Per-stage and per-thread totals, one per line
+    static juce::String getReport();
+    static const char* getStageName(Stage stage) noexcept;
+
+    // Checks that growing a juce::Array and juce::Path inside a ScopedStage is
+    // counted, i.e. that malloc/realloc are hooked on this platform (not on
+    // Windows, where only operator new is). Logs and returns false if not.
+    static bool runSelfCheck();
+
+    // Called by the replaced operator new and the malloc hooks
+    static void noteAllocation() noexcept;
+
+private:
+    static Stage enterStage(Stage stage) noexcept;
+};
@@ -0,0 +1,198 @@
+#include "ChromeTraceWriter.h"
+
+//==============================================================================
+namespace
+{
+    bool isMidiThreadEvent(TraceLog::EventType type)
+    {
+        switch (type)
+        {
+            case TraceLog::EventType::midiArrival:
+            case TraceLog::EventType::midiCallbackEnd:
+            case TraceLog::EventType::filterAccepted:
+            case TraceLog::EventType::filterRejected:
+            case TraceLog::EventType::enqueued:
+            case TraceLog::EventType::queueOverflow:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    juce::String toHex(juce::uint64 value)
+    {
+        return "\"0x" + juce::String::toHexString(static_cast<juce::int64>(value)) + "\"";
+    }
+}
+
+//==============================================================================
+ChromeTraceWriter::ChromeTraceWriter(juce::OutputStream& outputStream, juce::int64 ticksPerSecond, juce::int64 originTicks)
+    : out(outputStream),
+      microsecondsPerTick(1.0e6 / static_cast<double>(ticksPerSecond)),
+      origin(originTicks)
+{
+    unpaintedNotes.reserve(1024);
+}
+
+void ChromeTraceWriter::writeHeader()
+{
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    writeEvent("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"iLumidi\"}}");
+}
+
+void ChromeTraceWriter::writeFooter(juce::uint64 numRecordsWritten, juce::uint64 numRecordsDropped)
+{
+    out << "\n],\"metadata\":{\"recordsWritten\":" << juce::String(numRecordsWritten)
+        << ",\"recordsDropped\":" << juce::String(numRecordsDropped)
+        << ",\"complete\":" << (numRecordsDropped == 0 ? "true" : "false") << "}}\n";
+}
+
+//==============================================================================
+void ChromeTraceWriter::write(const TraceLog::Record& record)
+{
+    using EventType = TraceLog::EventType;
+
+    nameThread(record);
+
+    switch (static_cast<EventType>(record.type))
+    {
+        case EventType::midiArrival:
+            writeSlice('B', "MIDI callback", record,
+                       "\"bytes\":" + toHex(record.value) + ",\"slot\":" + juce::String(static_cast<juce::int16>(record.slot)));
+            break;
+
+        case EventType::midiCallbackEnd:
+            writeSlice('E', "MIDI callback", record);
+            break;
+
+        case EventType::filterAccepted:
+            writeInstant("filter", record, "\"accepted\":true");
+            break;
+
+        case EventType::filterRejected:
+            writeInstant("filter", record, "\"accepted\":false");
+            break;
+
+        case EventType::enqueued:
+            writeInstant("queue handoff", record, "\"note\":" + toHex(record.id));
+
+            // Only note-ons become notes; anything else would start a flow nothing finishes
+            if ((record.value & 0xf0) == 0x90 && ((record.value >> 16) & 0x7f) != 0)
+                writeFlow('s', record, record.id);
+            break;
+
+        case EventType::queueOverflow:
+            writeInstant("queue overflow", record, "\"note\":" + toHex(record.id));
+            break;
+
+        case EventType::drainStart:
+            writeSlice('B', "queue drain", record);
+            break;
+
+        case EventType::drainEnd:
+            writeSlice('E', "queue drain", record, "\"events\":" + juce::String(record.value));
+            break;
+
+        case EventType::noteIngested:
+            writeInstant("note ingested", record,
+                         "\"note\":" + toHex(record.id) + ",\"key\":" + juce::String(record.value & 0xff)
+                             + ",\"velocity\":" + juce::String((record.value >> 8) & 0xff));
+            writeFlow('t', record, record.id);
+            unpaintedNotes.push_back(record.id);
+            break;
+
+        case EventType::noteRefused:
+            writeInstant("note refused", record, "\"note\":" + toHex(record.id));
+            writeFlow('f', record, record.id);
+            break;
+
+        case EventType::noteEvicted:
+            writeInstant("notes evicted", record, "\"count\":" + juce::String(record.value));
+            break;
+
+        case EventType::animationStart:
+            writeSlice('B', "animation update", record);
+            break;
+
+        case EventType::animationEnd:
+            writeSlice('E', "animation update", record, "\"notes\":" + juce::String(record.value));
+            break;
+
+        case EventType::repaintRequested:
+            if (record.value == TraceLog::fullRepaint)
+                writeInstant("repaint", record, "\"full\":true");
+            else
+                writeInstant("repaint", record, "\"x\":" + juce::String(record.value >> 16) + ",\"width\":" + juce::String(record.value & 0xffff));
+            break;
+
+        case EventType::frameStart:
+            writeSlice('B', "paint", record, "\"notes\":" + juce::String(record.value));
+
+            // Everything ingested before this paint began is drawn by it
+            for (auto id : unpaintedNotes)
+                writeFlow('f', record, id);
+
+            unpaintedNotes.clear();
+            break;
+
+        case EventType::frameEnd:
+            writeSlice('E', "paint", record);
+            break;
+
+        default:
+            writeInstant("unknown", record, "\"type\":" + juce::String(record.type));
+            break;
+    }
+}
+
+//==============================================================================
+void ChromeTraceWriter::writeEvent(const juce::String& json)
+{
+    if (!firstEvent)
+        out << ",\n";
+
+    out << json;
+    firstEvent = false;
+}
+
+void ChromeTraceWriter::writeSlice(char phase, const char* name, const TraceLog::Record& record, const juce::String& args)
+{
+    writeEvent("{\"name\":\"" + juce::String(name) + "\",\"cat\":\"pipeline\",\"ph\":\"" + juce::String::charToString(phase)
+               + "\",\"ts\":" + getTimestamp(record) + ",\"pid\":1,\"tid\":" + juce::String(record.thread)
+               + (args.isEmpty() ? juce::String() : ",\"args\":{" + args + "}") + "}");
+}
+
+void ChromeTraceWriter::writeInstant(const char* name, const TraceLog::Record& record, const juce::String& args)
+{
+    writeEvent("{\"name\":\"" + juce::String(name) + "\",\"cat\":\"pipeline\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" + getTimestamp(record)
+               + ",\"pid\":1,\"tid\":" + juce::String(record.thread)
+               + (args.isEmpty() ? juce::String() : ",\"args\":{" + args + "}") + "}");
+}
+
+void ChromeTraceWriter::writeFlow(char phase, const TraceLog::Record& record, juce::uint64 id)
+{
+    // Flow events bind to the slice enclosing them on the same thread
+    writeEvent("{\"name\":\"note\",\"cat\":\"note\",\"ph\":\"" + juce::String::charToString(phase) + "\",\"id\":" + toHex(id)
+               + ",\"bp\":\"e\",\"ts\":" + getTimestamp(record) + ",\"pid\":1,\"tid\":" + juce::String(record.thread) + "}");
+}
+
+void ChromeTraceWriter::nameThread(const TraceLog::Record& record)
+{
+    auto thread = static_cast<size_t>(record.thread);
+    if (thread >= namedThreads.size() || namedThreads[thread])
+        return;
+
+    // Threads register with TraceLog in whatever order they first record, so name them by what they do
+    auto name = isMidiThreadEvent(static_cast<TraceLog::EventType>(record.type)) ? "MIDI input " + juce::String(record.thread)
+                                                                                  : juce::String("Message thread");
+
+    writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + juce::String(record.thread)
+               + ",\"args\":{\"name\":\"" + name + "\"}}");
+    namedThreads[thread] = true;
+}
+
+juce::String ChromeTraceWriter::getTimestamp(const TraceLog::Record& record) const
+{
+    return juce::String(static_cast<double>(record.ticks - origin) * microsecondsPerTick, 3);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "TraceLog.h"
+#include <vector>
+
+//==============================================================================
+// Turns TraceLog records into Chrome Trace Event JSON as they are drained, so a
+// session opens directly in Perfetto or chrome://tracing. Begin/end record pairs
+// become slices, everything else becomes instant events. Each note gets a flow
+// that starts at the queue handoff in the MIDI callback, steps through ingestion
+// and finishes in the first paint after it was ingested, which is the first frame
+// that can show it. Runs on the trace writer thread only.
+class ChromeTraceWriter
+{
+public:
+    // Timestamps are written relative to originTicks, the moment tracing started
+    ChromeTraceWriter(juce::OutputStream& outputStream, juce::int64 ticksPerSecond, juce::int64 originTicks);
+
+    void writeHeader();
+    void write(const TraceLog::Record& record);
+    // The record counts go into the trace's metadata, so a trace with gaps says so
+    void writeFooter(juce::uint64 numRecordsWritten, juce::uint64 numRecordsDropped);
+
+private:
+    void writeEvent(const juce::String& json);
+    void writeSlice(char phase, const char* name, const TraceLog::Record& record, const juce::String& args = {});
+    void writeInstant(const char* name, const TraceLog::Record& record, const juce::String& args = {});
+    void writeFlow(char phase, const TraceLog::Record& record, juce::uint64 id);
+    void nameThread(const TraceLog::Record& record);
+
+    juce::String getTimestamp(const TraceLog::Record& record) const;
+
+    juce::OutputStream& out;
+    double microsecondsPerTick;
+    juce::int64 origin;
+    bool firstEvent = true;
+
+    std::vector<bool> namedThreads = std::vector<bool>(static_cast<size_t>(TraceLog::maxThreads), false);
+    std::vector<juce::uint64> unpaintedNotes; // ingested since the last frame started
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChromeTraceWriter)
+};
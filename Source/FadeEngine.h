@@ -0,0 +1,91 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "NoteEvent.h"
+#include <array>
+#include <cmath>
+
+//==============================================================================
+// Time-based note fade. A single fade clock advances by real elapsed time; each
+// note remembers where the clock stood when it arrived, and its alpha is looked
+// up from the age since then. Changing the rate or pausing the fade only changes
+// how fast the clock runs, so every note stays on the same curve and nothing
+// depends on how often paint() happens to be called.
+class FadeEngine
+{
+public:
+    enum class Shape
+    {
+        exponential,    // constant percentage per second, matches the original look
+        linear          // constant brightness per second
+    };
+
+    // Age (in clock steps) at which a note has faded out. NoteEvent::fadePhase
+    // wraps at twice this, so ages stay unambiguous.
+    static constexpr juce::uint32 fadeLengthSteps = (NoteEvent::fadePhaseMask + 1) / 2;
+    static constexpr float finalAlpha = 0.01f;
+
+    FadeEngine() { setShape(Shape::exponential); }
+
+    // Percent of brightness lost per 1/60 s, the slider's historical meaning. 0 holds every note.
+    void setFadeRate(float percentPerSixtiethOfASecond)
+    {
+        if (percentPerSixtiethOfASecond <= 0.0f)
+        {
+            stepsPerSecond = 0.0;
+            return;
+        }
+
+        auto keepPerSecond = std::pow(1.0 - juce::jmin(99.0, static_cast<double>(percentPerSixtiethOfASecond)) / 100.0, 60.0);
+        auto secondsToFadeOut = std::log(static_cast<double>(finalAlpha)) / std::log(keepPerSecond);
+        stepsPerSecond = fadeLengthSteps / secondsToFadeOut;
+    }
+
+    void setShape(Shape newShape)
+    {
+        shape = newShape;
+
+        for (juce::uint32 age = 0; age < fadeLengthSteps; ++age)
+        {
+            auto progress = static_cast<float>(age) / static_cast<float>(fadeLengthSteps);
+            alphaByAge[age] = shape == Shape::exponential ? std::pow(finalAlpha, progress)
+                                                          : 1.0f - (1.0f - finalAlpha) * progress;
+        }
+    }
+
+    Shape getShape() const noexcept { return shape; }
+    bool isHolding() const noexcept { return stepsPerSecond <= 0.0; }
+
+    // Animation step. Returns true if the clock moved so far that every existing note has expired.
+    bool advance(double elapsedSeconds) noexcept
+    {
+        auto steps = juce::jmax(0.0, elapsedSeconds) * stepsPerSecond;
+        clock += steps;
+        return steps >= fadeLengthSteps;
+    }
+
+    juce::uint32 getCurrentPhase() const noexcept
+    {
+        return static_cast<juce::uint32>(static_cast<juce::uint64>(clock)) & NoteEvent::fadePhaseMask;
+    }
+
+    juce::uint32 getAge(const NoteEvent& note) const noexcept
+    {
+        return (getCurrentPhase() - note.fadePhase) & NoteEvent::fadePhaseMask;
+    }
+
+    bool isExpired(const NoteEvent& note) const noexcept { return getAge(note) >= fadeLengthSteps; }
+
+    float getAlpha(const NoteEvent& note) const noexcept
+    {
+        auto age = getAge(note);
+        return age < fadeLengthSteps ? alphaByAge[age] : 0.0f;
+    }
+
+private:
+    Shape shape = Shape::exponential;
+    double clock = 0.0, stepsPerSecond = 0.0;
+    std::array<float, fadeLengthSteps> alphaByAge {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FadeEngine)
+};
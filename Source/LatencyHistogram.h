@@ -0,0 +1,93 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+//==============================================================================
+// HDR-style histogram of latencies in microseconds. Values below 128 us get a
+// bucket each; above that every power of two is split into 64 linear buckets, so
+// any recorded value is reported to within 1.6% from 1 us up to about 71 minutes.
+// Recording is a bit scan and an increment, with no allocation. Not thread-safe:
+// record and query from the same thread.
+class LatencyHistogram
+{
+public:
+    static constexpr int subBucketBits = 7;
+    static constexpr int subBucketCount = 1 << subBucketBits;          // exact buckets for values below this
+    static constexpr int subBucketHalfCount = subBucketCount / 2;      // buckets per power of two above it
+    static constexpr int numBuckets = subBucketCount + (32 - subBucketBits) * subBucketHalfCount;
+
+    struct Summary
+    {
+        juce::uint64 count = 0;
+        juce::uint32 p50 = 0, p99 = 0, p999 = 0, max = 0;
+    };
+
+    void record(juce::uint32 micros) noexcept
+    {
+        ++counts[static_cast<size_t>(getBucketIndex(micros))];
+        ++totalCount;
+        maxValue = juce::jmax(maxValue, micros);
+    }
+
+    void reset() noexcept
+    {
+        counts.fill(0);
+        totalCount = 0;
+        maxValue = 0;
+    }
+
+    juce::uint64 getCount() const noexcept { return totalCount; }
+    juce::uint32 getMax() const noexcept { return maxValue; }
+
+    // Smallest bucket bound that at least 'percentile' percent of recorded values fall under
+    juce::uint32 getPercentile(double percentile) const noexcept
+    {
+        if (totalCount == 0)
+            return 0;
+
+        auto target = static_cast<juce::uint64>(std::ceil(juce::jlimit(0.0, 100.0, percentile) / 100.0 * static_cast<double>(totalCount)));
+        target = juce::jmax(static_cast<juce::uint64>(1), target);
+
+        juce::uint64 seen = 0;
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            seen += counts[static_cast<size_t>(i)];
+            if (seen >= target)
+                return juce::jmin(maxValue, getBucketUpperBound(i));
+        }
+
+        return maxValue;
+    }
+
+    Summary getSummary() const noexcept
+    {
+        return { totalCount, getPercentile(50.0), getPercentile(99.0), getPercentile(99.9), maxValue };
+    }
+
+    static int getBucketIndex(juce::uint32 micros) noexcept
+    {
+        if (micros < static_cast<juce::uint32>(subBucketCount))
+            return static_cast<int>(micros);
+
+        auto shift = juce::findHighestSetBit(micros) - (subBucketBits - 1);
+        auto subBucket = static_cast<int>(micros >> shift);    // in [subBucketHalfCount, subBucketCount)
+        return subBucketCount + (shift - 1) * subBucketHalfCount + (subBucket - subBucketHalfCount);
+    }
+
+    static juce::uint32 getBucketUpperBound(int index) noexcept
+    {
+        if (index < subBucketCount)
+            return static_cast<juce::uint32>(index);
+
+        auto shift = (index - subBucketCount) / subBucketHalfCount + 1;
+        auto subBucket = static_cast<juce::uint64>((index - subBucketCount) % subBucketHalfCount + subBucketHalfCount);
+        return static_cast<juce::uint32>(((subBucket + 1) << shift) - 1);
+    }
+
+private:
+    std::array<juce::uint64, numBuckets> counts {};
+    juce::uint64 totalCount = 0;
+    juce::uint32 maxValue = 0;
+};
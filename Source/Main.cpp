@@ -1,5 +1,7 @@
 #include <JuceHeader.h>
 #include "MainComponent.h"
+#include "TraceLog.h"
+#include "StartupProfile.h"
 
 //==============================================================================
 class iLumidiApplication : public juce::JUCEApplication, public juce::MenuBarModel
@@ -15,15 +17,41 @@ public:
     //==============================================================================
     void initialise(const juce::String& commandLine) override
     {
+        StartupProfile::mark(StartupProfile::Milestone::initialise);
+
+        // --trace records the MIDI-to-frame pipeline into a binary trace file;
+        // --trace-json writes Chrome Trace Event JSON for Perfetto instead
+        if (commandLine.contains("--trace"))
+        {
+            auto asJson = commandLine.contains("--trace-json");
+            auto traceFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                                 .getChildFile("iLumidi Traces")
+                                 .getChildFile("trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S")
+                                               + (asJson ? ".json" : ".iltrace"));
+            TraceLog::getInstance().start(traceFile, asJson ? TraceLog::Format::chromeJson : TraceLog::Format::binary);
+        }
+
         mainWindow = std::make_unique<MainWindow>(getApplicationName());
         mainWindow->initialize();
         mainWindow->setMenuBar(this);
+        StartupProfile::mark(StartupProfile::Milestone::windowVisible);
+
+        // --alloc-test: run the realtime allocation check for 10 s, then quit with
+        // a non-zero exit code if the MIDI callback or a frame allocated
+        if (commandLine.contains("--alloc-test"))
+        {
+            mainWindow->getMainComponent()->runAllocationTest(10.0, [this](bool passed) {
+                setApplicationReturnValue(passed ? 0 : 1);
+                systemRequestedQuit();
+            });
+        }
     }
 
     void shutdown() override
     {
         mainWindow->setMenuBar(nullptr);
         mainWindow = nullptr;
+        TraceLog::getInstance().stop();
     }
 
     //==============================================================================
@@ -102,7 +130,88 @@ private:
             menu.addItem("Quit", [] { JUCEApplication::getInstance()->systemRequestedQuit(); });
         }
 
-        // Add other menu items for "Edit", "View", and "Help" as needed
+        else if (menuName == "View")
+        {
+            if (auto* mainComponent = dynamic_cast<MainComponent*>(mainWindow->getContentComponent()))
+            {
+                menu.addItem("Performance HUD", true, mainComponent->isPerformanceHudVisible(), [mainComponent] {
+                    mainComponent->setPerformanceHudVisible(!mainComponent->isPerformanceHudVisible());
+                });
+                menu.addItem("Reset Latency Histogram", mainComponent->getNoteLatency().getCount() > 0, false, [mainComponent] {
+                    mainComponent->resetNoteLatency();
+                });
+                menu.addSubMenu("Note Pool", getNotePoolMenu(*mainComponent));
+
+                // Load generator for stress and soak tests; only listed while Shift is held
+                if (juce::ModifierKeys::getCurrentModifiersRealtime().isShiftDown())
+                    menu.addSubMenu("Synthetic MIDI", getSyntheticMidiMenu(*mainComponent));
+            }
+        }
+
+        // Add other menu items for "Edit" and "Help" as needed
+
+        return menu;
+    }
+
+    juce::PopupMenu getNotePoolMenu(MainComponent& mainComponent)
+    {
+        using Policy = NotePool::OverflowPolicy;
+
+        juce::PopupMenu menu;
+        const auto& pool = mainComponent.getNotePool();
+
+        for (auto capacity : { 1024, 4096, NotePool::defaultCapacity, 65536 })
+            menu.addItem(juce::String(capacity) + " notes", true, pool.getCapacity() == capacity,
+                         [&mainComponent, capacity] { mainComponent.setNoteCapacity(capacity); });
+
+        menu.addSeparator();
+
+        const std::pair<Policy, const char*> policies[] { { Policy::dropOldest, "When Full: Drop Oldest" },
+                                                          { Policy::dropQuietest, "When Full: Drop Quietest" },
+                                                          { Policy::refuse, "When Full: Refuse New Notes" } };
+        for (const auto& [policy, name] : policies)
+            menu.addItem(name, true, pool.getOverflowPolicy() == policy,
+                         [&mainComponent, policy = policy] { mainComponent.setNoteOverflowPolicy(policy); });
+
+        menu.addSeparator();
+        menu.addItem("Reset Drop Counters", true, false, [&mainComponent] { mainComponent.resetNoteOverflowCounters(); });
+
+        return menu;
+    }
+
+    juce::PopupMenu getSyntheticMidiMenu(MainComponent& mainComponent)
+    {
+        using Generator = SyntheticMidiGenerator;
+
+        juce::PopupMenu menu;
+        const auto* running = mainComponent.getSyntheticMidiSettings();
+        auto numDevices = running != nullptr ? running->numDevices : 1;
+
+        for (auto pattern : Generator::getAllPatterns())
+        {
+            auto isRunning = running != nullptr && running->pattern == pattern;
+            auto rate = Generator::getDefaultRate(pattern);
+
+            menu.addItem(Generator::getPatternName(pattern) + " (" + juce::String(juce::roundToInt(rate)) + "/s)", true, isRunning,
+                         [&mainComponent, pattern, rate, numDevices] {
+                             Generator::Settings settings;
+                             settings.pattern = pattern;
+                             settings.eventsPerSecond = rate;
+                             settings.numDevices = numDevices;
+                             mainComponent.startSyntheticMidi(settings);
+                         });
+        }
+
+        menu.addSeparator();
+        menu.addItem("Interleave 4 devices", running != nullptr, numDevices > 1, [&mainComponent] {
+            if (const auto* current = mainComponent.getSyntheticMidiSettings())
+            {
+                auto settings = *current;
+                settings.numDevices = settings.numDevices > 1 ? 1 : 4;
+                mainComponent.startSyntheticMidi(settings);
+            }
+        });
+        menu.addItem("Stop", running != nullptr, false, [&mainComponent] { mainComponent.stopSyntheticMidi(); });
 
         return menu;
     }
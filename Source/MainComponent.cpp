@@ -1,8 +1,6 @@
 #include "MainComponent.h"
 #include "CustomLookAndFeel.h"
 #include <algorithm>
-#include <vector>
-#include <ranges>
 
 //==============================================================================
 class MainComponent::SettingsWindowCloseButtonHandler : public juce::DocumentWindow
@@ -32,10 +30,13 @@ private:
 //==============================================================================
 MainComponent::MainComponent()
     : settingsWindow(nullptr),
-      fadeRateSlider(), disableFadeToggle(), scanButton(), noteColorSelector(),
+      fadeRateSlider(), disableFadeToggle(), scanButton(),
       applyButton(),
       instantUpdateToggle(),
-      fadeRate(5.0f), noteColor(juce::Colours::white), customLookAndFeel(), instantUpdateMode(false)
+      customLookAndFeel(),
+      sessionStore([this] { return createSessionState(); }),
+      deviceWatcher([this](const auto& added, const auto& removed) { midiDevicesChanged(added, removed); }),
+      vBlankAttachment(this, [this] { onVBlank(); })
 {
     setLookAndFeel(&customLookAndFeel);
     setSize(800, 600);
@@ -46,17 +47,14 @@ MainComponent::MainComponent()
 
     disableFadeToggle.setButtonText("Disable Fade");
     disableFadeToggle.addListener(this);
+
+    applyRenderSettings();
 }
 
 void MainComponent::initialize()
 {
     DBG("MainComponent initialized. Size: " + juce::String(getWidth()) + "x" + juce::String(getHeight()));
 
-    refreshMidiInputs();
-
-    DBG("Opening selected MIDI inputs:");
-    openSelectedMidiInputs();
-
     fadeRateSlider.setRange(0.1, 20.0, 0.1);
     fadeRateSlider.setValue(5.0);
     fadeRateSlider.addListener(this);
@@ -67,12 +65,9 @@ void MainComponent::initialize()
     disableFadeToggle.setButtonText("Disable Fade");
     disableFadeToggle.addListener(this);
 
-    fadeRate = static_cast<float>(fadeRateSlider.getValue());
-
-    noteColorSelector.setCurrentColour(juce::Colours::white);
-    noteColorSelector.addChangeListener(this);
-
-    noteColor = noteColorSelector.getCurrentColour();
+    updateRenderSettings([this](RenderSettings& settings) {
+        settings.fadeRate = static_cast<float>(fadeRateSlider.getValue());
+    });
 
     scanButton.setButtonText("Scan");
     scanButton.addListener(this);
@@ -97,6 +92,26 @@ void MainComponent::initialize()
     enableMode2Button.setButtonText("Enable Mode 2");
     enableMode2Button.addListener(this);
     addAndMakeVisible(&enableMode2Button);
+
+    // Remembered devices are opened as soon as the watcher finds them
+    restoreSession();
+
+    // Normally the first vblank after the first paint starts device setup; a
+    // minimised or hidden window may never paint, so don't wait on it for long
+    juce::Component::SafePointer<MainComponent> safeThis(this);
+    juce::Timer::callAfterDelay(midiDeviceSetupDelayMs, [safeThis] {
+        if (safeThis != nullptr)
+            safeThis->startMidiDeviceSetup();
+    });
+}
+
+void MainComponent::startMidiDeviceSetup()
+{
+    if (midiDeviceSetupStarted)
+        return;
+
+    midiDeviceSetupStarted = true;
+    deviceWatcher.start();
 }
 
 //==============================================================================
@@ -107,26 +122,25 @@ MainComponent::~MainComponent()
     disableFadeToggle.removeListener(this);
     scanButton.removeListener(this);
     applyButton.removeListener(this);
-    noteColorSelector.removeChangeListener(this);
+    if (noteColorSelector != nullptr)
+        noteColorSelector->removeChangeListener(this);
     instantUpdateToggle.removeListener(this);
     enableMode1Button.removeListener(this);
     enableMode2Button.removeListener(this);
 
-    for (auto* deviceToggle : midiDeviceToggles)
-        deviceToggle->removeListener(this);
+    setLookAndFeel(nullptr);
 
-    for (auto* channelToggles : midiChannelToggles)
-        for (auto* channelToggle : *channelToggles)
-            channelToggle->removeListener(this);
+    // Written by the store's thread; the state is built now, while everything is alive
+    sessionStore.flush();
 
-    setLookAndFeel(nullptr);
+    stopSyntheticMidi();
 
-    for (auto* device : midiInputsOpened)
-    {
-        if (device != nullptr)
-            device->stop();
-    }
-    midiInputsOpened.clear(true);
+    // Stop every input before anything it calls back into goes away; completions
+    // are dropped, and the queues are left bound as nothing will drain them again
+    for (int slot = 0; slot < midiDevices.getNumSlots(); ++slot)
+        closeMidiInput(midiDevices[slot]);
+
+    midiDeviceWorker.finish();
 
     if (settingsWindow != nullptr)
     {
@@ -139,54 +153,51 @@ MainComponent::~MainComponent()
 //==============================================================================
 void MainComponent::paint(juce::Graphics& g)
 {
-    // Fill the background
-    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+    AllocationTracker::ScopedStage allocationStage(AllocationTracker::Stage::render);
+    TraceLog::record(TraceLog::EventType::frameStart, 0, static_cast<juce::uint32>(notes.size()));
+    auto paintStartTicks = juce::Time::getHighResolutionTicks();
 
-    // Reduced paint call logging
-    static int paintCallCount = 0;
-    static juce::uint32 lastPaintTime = 0;
-    juce::uint32 currentTime = juce::Time::getMillisecondCounter();
+    // Pure read of the note state; fading happens in advanceAnimation()
+    noteRenderer.batchNotes(g.getClipBounds(), notes, fadeEngine);
 
-    if (currentTime - lastPaintTime > 1000 || !midiMessages.empty())
+    // Every fill allocates somewhere in JUCE's renderer or the OS (edge tables,
+    // CGPaths), which no amount of reuse on our side avoids
     {
-        DBG("Paint called (" + juce::String(++paintCallCount) + "). Number of MIDI messages: " + juce::String(midiMessages.size()));
-        lastPaintTime = currentTime;
+        AllocationTracker::ScopedStage rasteriserStage(AllocationTracker::Stage::rasteriser);
+        g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+        noteRenderer.fillBatches(g, renderSettings.read()->noteColour);
     }
 
-    g.setColour(juce::Colours::white);
-    for (auto& pair : midiMessages)
+    // First frame for these notes: measure key press to light. MIDI timestamps use the
+    // millisecond counter's clock, and both sides wrap together in 32-bit microseconds.
+    if (notes.getNextSequence() != firstUnpaintedNote)
     {
-        auto& message = pair.first;
-        float& alpha = pair.second;
-        if (message.isNoteOn())
-        {
-            int noteNumber = message.getNoteNumber();
-            float velocity = static_cast<float>(message.getVelocity()) / 127.0f;
-            float x = static_cast<float>(getWidth()) * static_cast<float>(noteNumber) / 127.0f;
-            float height = static_cast<float>(getHeight()) * velocity;
-
-            juce::Colour noteColour = noteColor.withAlpha(alpha);
+        auto now = NoteEvent::timestampFromSeconds(juce::Time::getMillisecondCounterHiRes() * 0.001);
+        notes.forEachSince(firstUnpaintedNote, [this, now](const NoteEvent& note) { noteLatency.record(now - note.timestamp); });
+        firstUnpaintedNote = notes.getNextSequence();
+    }
 
-            g.setColour(noteColour);
+    if (performanceHud.isVisible())
+        performanceHud.paintFinished(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - paintStartTicks) * 1000.0);
 
-            juce::Path triangle;
-            triangle.addTriangle(x, static_cast<float>(getHeight()) - height, x + 10.0f, static_cast<float>(getHeight()), x - 10.0f, static_cast<float>(getHeight()));
-            g.fillPath(triangle);
+    TraceLog::record(TraceLog::EventType::frameEnd, 0, static_cast<juce::uint32>(notes.size()));
 
-            if (!disableFadeToggle.getToggleState())
-            {
-                alpha *= (1.0f - fadeRate / 100.0f);
-            }
-        }
-    }
+    if (!StartupProfile::has(StartupProfile::Milestone::firstPaint))
+        StartupProfile::mark(StartupProfile::Milestone::firstPaint);
+}
 
-    // Remove messages with alpha less than 0.01
-    std::erase_if(midiMessages, [](const auto& pair) { return pair.second < 0.01f; });
+void MainComponent::paintOverChildren(juce::Graphics& g)
+{
+    // The mode buttons are opaque children, so the HUD goes on after them
+    if (performanceHud.isVisible() && g.clipRegionIntersects(performanceHud.getBounds()))
+        performanceHud.draw(g);
 }
 
 //==============================================================================
 void MainComponent::resized()
 {
+    noteRenderer.setCanvasSize(getWidth(), getHeight());
+
     auto area = getLocalBounds().reduced(10);
     enableMode1Button.setBounds(area.removeFromTop(30));
     enableMode2Button.setBounds(area.removeFromTop(30));
@@ -196,10 +207,13 @@ void MainComponent::resized()
 //==============================================================================
 void MainComponent::noteColorChanged()
 {
-    noteColor = noteColorSelector.getCurrentColour();
-    DBG("Note color changed to: " + noteColor.toString());
+    updateRenderSettings([this](RenderSettings& settings) {
+        settings.noteColour = noteColorSelector->getCurrentColour();
+    });
+    saveSession();
+    DBG("Note color changed to: " + renderSettings.read()->noteColour.toString());
 
-    if (instantUpdateMode)
+    if (renderSettings.read()->instantColourUpdate)
     {
         repaint();
     }
@@ -207,134 +221,478 @@ void MainComponent::noteColorChanged()
 
 void MainComponent::handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message)
 {
-    DBG("Incoming MIDI Message from: " + source->getName() + " Channel: " + juce::String(message.getChannel()));
+    pushMidiMessage(findMidiInputSlot(source), message);
+}
 
-    updateMidiDeviceSelections();
+void MainComponent::pushMidiMessage(int slot, const juce::MidiMessage& message) noexcept
+{
+    AllocationTracker::ScopedStage allocationStage(AllocationTracker::Stage::midiCallback);
+
+    // Realtime thread: trace records only, no string building
+    auto traceSlot = static_cast<juce::uint16>(slot);
+    auto rawBytes = TraceLog::packBytes(message.getRawData(), message.getRawDataSize());
+    TraceLog::record(TraceLog::EventType::midiArrival, 0, rawBytes, traceSlot);
 
     // Process the MIDI message if it's from a selected device and channel
-    if (selectedMidiDevices.contains(source->getName()) &&
-        (selectedChannels.isEmpty() || selectedChannels.contains(message.getChannel())))
+    if (slot >= 0 && midiInputFilter.read()->accepts(slot, message.getChannel()))
     {
-        DBG("Processing MIDI message");
-        processMidiMessage(message);
+        TraceLog::record(TraceLog::EventType::filterAccepted, 0, rawBytes, traceSlot);
+
+        // Hand the message over to the message thread; it is processed in onVBlank()
+        auto& queue = midiInputQueues[static_cast<size_t>(slot)].events;
+        auto noteId = TraceLog::makeNoteId(slot, queue.getNextSequence());
+
+        if (queue.push(message))
+            TraceLog::record(TraceLog::EventType::enqueued, noteId, rawBytes, traceSlot);
+        else
+            TraceLog::record(TraceLog::EventType::queueOverflow, noteId, rawBytes, traceSlot);
+
+        framePending.store(true, std::memory_order_release);
     }
     else
     {
-        DBG("MIDI message not from selected device/channel");
+        TraceLog::record(TraceLog::EventType::filterRejected, 0, rawBytes, traceSlot);
     }
+
+    TraceLog::record(TraceLog::EventType::midiCallbackEnd, 0, 0, traceSlot);
 }
 
 //==============================================================================
-void MainComponent::processMidiMessage(const juce::MidiMessage& message)
+void MainComponent::processMidiMessage(const MidiEvent& event, int inputSlot, juce::uint64 noteId)
 {
-    DBG("Processing MIDI message; Note ON: " + juce::String(message.getNoteNumber()) + ", Channel: " + juce::String(message.getChannel()));
-    if (message.isNoteOn())
+    NoteEvent note;
+    if (NoteEvent::fromMidiEvent(event, inputSlot, fadeEngine.getCurrentPhase(), note))
     {
-        midiMessages.emplace_back(message, 1.0f);
-        DBG("Added message to midiMessages; size: " + juce::String(midiMessages.size()));
+        auto traceSlot = static_cast<juce::uint16>(inputSlot);
 
-        if (midiMessages.size() > 100)
+        if (notes.add(note))
+        {
+            TraceLog::record(TraceLog::EventType::noteIngested, noteId, note.noteNumber | (note.velocity << 8), traceSlot);
+            dirtyRegions.markNote(note);
+            ++numNotesIngested;
+        }
+        else
         {
-            midiMessages.erase(midiMessages.begin());
-            DBG("Erased oldest message; new size: " + juce::String(midiMessages.size()));
+            TraceLog::record(TraceLog::EventType::noteRefused, noteId, note.noteNumber | (note.velocity << 8), traceSlot);
         }
     }
-
-    // Ensure repaint is called after processing a message
-    if (!isTimerRunning())
-        startTimerHz(60); // Repaint at 60 FPS
 }
 
 //==============================================================================
-void MainComponent::timerCallback()
+void MainComponent::setNoteCapacity(int capacity)
 {
+    notes.setCapacity(capacity);
     repaint();
+    DBG("Note pool capacity: " + juce::String(notes.getCapacity()));
+}
 
-    // Stop the timer if there are no MIDI messages to process
-    if (midiMessages.empty())
-        stopTimer();
+void MainComponent::setNoteOverflowPolicy(NotePool::OverflowPolicy policy)
+{
+    notes.setOverflowPolicy(policy);
 }
 
-//==============================================================================
-void MainComponent::refreshMidiInputs()
+void MainComponent::setFadeShape(FadeEngine::Shape shape)
+{
+    updateRenderSettings([shape](RenderSettings& settings) { settings.fadeShape = shape; });
+    saveSession();
+    repaint();
+}
+
+bool MainComponent::startSyntheticMidi(const SyntheticMidiGenerator::Settings& settings)
 {
-    DBG("Starting refreshMidiInputs()");
-    auto midiInputs = juce::MidiInput::getAvailableDevices();
-    DBG("Refreshing MIDI Inputs:");
+    stopSyntheticMidi();
+
+    // One queue per virtual device, taken from whatever real inputs left free
+    std::array<int, SyntheticMidiGenerator::maxDevices> slots {};
+    int numSlots = 0;
+
+    for (int i = 0; i < maxOpenMidiInputs && numSlots < juce::jmin(settings.numDevices, SyntheticMidiGenerator::maxDevices); ++i)
+    {
+        auto& slot = midiInputQueues[static_cast<size_t>(i)];
+        if (slot.synthetic || slot.source.load(std::memory_order_relaxed) != nullptr)
+            continue;
+
+        slot.events.reset();
+        slot.synthetic = true;
+        slots[static_cast<size_t>(numSlots++)] = i;
+    }
 
-    // Update MIDI devices
-    for (const auto& input : midiInputs)
+    if (numSlots == 0)
     {
-        DBG("Found MIDI input: " + input.name + " (ID: " + input.identifier + ")");
+        DBG("No free MIDI event queue for synthetic MIDI");
+        return false;
+    }
+
+    publishMidiInputFilter();
+
+    syntheticMidi = std::make_unique<SyntheticMidiPlayer>(settings, [this, slots, numSlots](int device, const juce::MidiMessage& message) {
+        pushMidiMessage(slots[static_cast<size_t>(device % numSlots)], message);
+    });
+
+    DBG("Synthetic MIDI: " + SyntheticMidiGenerator::getPatternName(settings.pattern) + " at "
+        + juce::String(settings.eventsPerSecond) + " events/s on " + juce::String(numSlots) + " slot(s)");
+    return true;
+}
 
-        int existingIndex = midiDevicesList.indexOf(input.name);
-        if (existingIndex != -1)
+void MainComponent::stopSyntheticMidi()
+{
+    if (syntheticMidi == nullptr)
+        return;
+
+    syntheticMidi.reset();
+
+    for (auto& slot : midiInputQueues)
+    {
+        if (slot.synthetic)
         {
-            continue;
+            slot.synthetic = false;
+            slot.events.reset();
         }
+    }
+
+    publishMidiInputFilter();
+}
+
+const SyntheticMidiGenerator::Settings* MainComponent::getSyntheticMidiSettings() const noexcept
+{
+    return syntheticMidi != nullptr ? &syntheticMidi->getSettings() : nullptr;
+}
+
+void MainComponent::runAllocationTest(double seconds, std::function<void(bool passed)> onFinished)
+{
+    if (!AllocationTracker::isEnabled)
+    {
+        juce::Logger::writeToLog(AllocationTracker::getReport());
+        onFinished(false);
+        return;
+    }
+
+    // A tracker that can't see HeapBlock growth would pass every run
+    if (!AllocationTracker::runSelfCheck())
+    {
+        onFinished(false);
+        return;
+    }
+
+    // Chords exercise the dirty-column and path batching code harder than single notes
+    SyntheticMidiGenerator::Settings settings;
+    settings.pattern = SyntheticMidiGenerator::Pattern::chordClusters;
+    settings.eventsPerSecond = 5000.0;
+    settings.numDevices = 2;
+
+    if (!startSyntheticMidi(settings))
+    {
+        onFinished(false);
+        return;
+    }
+
+    // Long enough for the pool and render paths to reach their working set
+    constexpr int warmUpMs = 2000;
+
+    juce::Component::SafePointer<MainComponent> safeThis(this);
+    juce::Timer::callAfterDelay(warmUpMs, [safeThis, seconds, onFinished] {
+        if (safeThis == nullptr)
+            return;
+
+        AllocationTracker::setRealtimeCheckArmed(true);
+
+        juce::Timer::callAfterDelay(juce::roundToInt(seconds * 1000.0), [safeThis, onFinished] {
+            AllocationTracker::setRealtimeCheckArmed(false);
+
+            if (safeThis == nullptr)
+                return;
+
+            safeThis->stopSyntheticMidi();
 
-        midiDevicesList.add(input.name);
+            auto passed = AllocationTracker::getNumRealtimeViolations() == 0;
+            juce::Logger::writeToLog(juce::String("Allocation test ") + (passed ? "passed" : "FAILED") + "\n" + AllocationTracker::getReport());
+            onFinished(passed);
+        });
+    });
+}
+
+void MainComponent::setPerformanceHudVisible(bool shouldBeVisible)
+{
+    performanceHud.setVisible(shouldBeVisible);
+    peakQueueDepth = 0;
+
+    if (shouldBeVisible)
+        refreshPerformanceHud(juce::Time::getMillisecondCounterHiRes());
+    else
+        repaint(performanceHud.getBounds());
+}
+
+//==============================================================================
+void MainComponent::onVBlank()
+{
+    applyRenderSettings();
+
+    // Device setup waits until the first frame is on screen, keeping enumeration
+    // (synchronous on macOS) off the cold start path
+    if (!midiDeviceSetupStarted && StartupProfile::has(StartupProfile::Milestone::firstPaint))
+        startMidiDeviceSetup();
+
+    // The HUD keeps sampling while the pipeline is idle so it can show that too
+    if (performanceHud.isVisible())
+    {
+        auto now = juce::Time::getMillisecondCounterHiRes();
+        performanceHud.frameStarted(now);
+
+        if (performanceHud.isRefreshDue(now))
+            refreshPerformanceHud(now);
+    }
+
+    // Idle frames cost one atomic exchange until the MIDI thread flags new work
+    auto hasNewEvents = framePending.exchange(false, std::memory_order_acquire);
+    if (!hasNewEvents && (notes.isEmpty() || fadeEngine.isHolding()))
+    {
+        lastAnimationTime = 0.0;
+        return;
+    }
+
+    // Age what's on screen first so notes arriving this frame start fully lit
+    {
+        AllocationTracker::ScopedStage allocationStage(AllocationTracker::Stage::animation);
+        TraceLog::record(TraceLog::EventType::animationStart);
+        advanceAnimation();
+        TraceLog::record(TraceLog::EventType::animationEnd, 0, static_cast<juce::uint32>(notes.size()));
+    }
+
+    drainMidiEventQueues();
+    dirtyRegions.flush(*this);
+}
+
+//==============================================================================
+void MainComponent::applyRenderSettings()
+{
+    const auto* settings = renderSettings.read();
+    if (settings->version == appliedRenderSettingsVersion)
+        return;
+
+    fadeEngine.setFadeRate(settings->getEffectiveFadeRate());
+    if (settings->fadeShape != fadeEngine.getShape())
+        fadeEngine.setShape(settings->fadeShape);
+
+    appliedRenderSettingsVersion = settings->version;
+}
+
+//==============================================================================
+void MainComponent::advanceAnimation()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+    auto elapsedSeconds = lastAnimationTime > 0.0 ? (now - lastAnimationTime) * 0.001 : 0.0;
+    lastAnimationTime = now;
+
+    if (fadeEngine.advance(elapsedSeconds))
+    {
+        notes.clear();
+        dirtyRegions.markAll();
+        return;
+    }
+
+    // Every note on screen changes brightness when the fade clock ticks over a step.
+    // Notes can only expire on such a tick, so the ones removed below are covered too.
+    auto fadePhase = fadeEngine.getCurrentPhase();
+    if (fadePhase != lastFadePhase)
+    {
+        notes.forEach([this](const NoteEvent& note) { dirtyRegions.markNote(note); });
+        lastFadePhase = fadePhase;
+    }
+
+    notes.removeExpired([this](const NoteEvent& note) { return fadeEngine.isExpired(note); });
+}
+
+void MainComponent::refreshPerformanceHud(double nowMs)
+{
+    const auto& overflow = notes.getOverflowCounters();
+
+    PerformanceHud::Stats stats;
+    stats.liveNotes = notes.size();
+    stats.noteCapacity = notes.getCapacity();
+    stats.notesIngested = numNotesIngested;
+    stats.peakQueueDepth = peakQueueDepth;
+    stats.queueDrops = getMidiQueueOverflowCount();
+    stats.poolDrops = overflow.droppedOldest + overflow.droppedQuietest + overflow.refused;
+    stats.latency = noteLatency.getSummary();
+
+    performanceHud.refresh(stats, nowMs);
+    peakQueueDepth = 0;
+    repaint(performanceHud.getBounds());
+}
+
+//==============================================================================
+int MainComponent::findMidiInputSlot(juce::MidiInput* source) const noexcept
+{
+    // Called on the MIDI thread: a handful of atomic loads, no locks
+    for (int i = 0; i < maxOpenMidiInputs; ++i)
+        if (midiInputQueues[static_cast<size_t>(i)].source.load(std::memory_order_acquire) == source)
+            return i;
 
-        auto deviceToggle = std::make_unique<juce::ToggleButton>(input.name);
-        deviceToggle->setColour(juce::ToggleButton::textColourId, juce::Colours::black);
-        deviceToggle->setColour(juce::ToggleButton::tickDisabledColourId, juce::Colours::black);
-        deviceToggle->setColour(juce::ToggleButton::tickColourId, juce::Colours::black);
-        deviceToggle->addListener(this);
-        midiDeviceToggles.add(deviceToggle.release());
+    return -1;
+}
 
-        auto channelToggles = std::make_unique<juce::OwnedArray<juce::ToggleButton>>();
-        for (int i = 1; i <= 16; ++i)
+int MainComponent::bindMidiEventQueue(juce::MidiInput* source, int deviceSlot)
+{
+    for (int i = 0; i < maxOpenMidiInputs; ++i)
+    {
+        auto& slot = midiInputQueues[static_cast<size_t>(i)];
+        if (!slot.synthetic && slot.source.load(std::memory_order_relaxed) == nullptr)
         {
-            auto channelToggle = std::make_unique<juce::ToggleButton>("Ch " + juce::String(i));
-            channelToggle->setColour(juce::ToggleButton::textColourId, juce::Colours::black);
-            channelToggle->setColour(juce::ToggleButton::tickDisabledColourId, juce::Colours::black);
-            channelToggle->setColour(juce::ToggleButton::tickColourId, juce::Colours::black);
-            channelToggle->addListener(this);
-            channelToggles->add(channelToggle.release());
+            slot.events.reset();
+            slot.deviceSlot = deviceSlot;
+            slot.source.store(source, std::memory_order_release);
+            return i;
         }
-        midiChannelToggles.add(channelToggles.release());
     }
 
-    // Remove devices that are no longer present
-    for (int i = midiDevicesList.size() - 1; i >= 0; --i)
+    return -1;
+}
+
+void MainComponent::releaseMidiEventQueue(int queueSlot)
+{
+    if (!juce::isPositiveAndBelow(queueSlot, maxOpenMidiInputs))
+        return;
+
+    auto& slot = midiInputQueues[static_cast<size_t>(queueSlot)];
+    slot.source.store(nullptr, std::memory_order_release);
+    slot.deviceSlot = -1;
+    slot.events.reset();
+}
+
+void MainComponent::drainMidiEventQueues()
+{
+    auto numEvictedBefore = notes.getOverflowCounters().droppedOldest + notes.getOverflowCounters().droppedQuietest;
+    int numDrained = 0;
+
+    TraceLog::record(TraceLog::EventType::drainStart);
+
     {
-        bool deviceStillPresent = false;
-        for (const auto& input : midiInputs)
+        AllocationTracker::ScopedStage allocationStage(AllocationTracker::Stage::ingestion);
+
+        for (int i = 0; i < maxOpenMidiInputs; ++i)
         {
-            if (input.name == midiDevicesList[i])
+            auto& slot = midiInputQueues[static_cast<size_t>(i)];
+            if (slot.synthetic || slot.source.load(std::memory_order_acquire) != nullptr)
             {
-                deviceStillPresent = true;
-                break;
+                // How far this input's queue filled up since the last frame emptied it
+                peakQueueDepth = juce::jmax(peakQueueDepth, slot.events.getNumReady());
+
+                numDrained += slot.events.drain([this, i](const MidiEvent& event) {
+                    processMidiMessage(event, i, TraceLog::makeNoteId(i, event.sequence));
+                });
             }
         }
-        if (!deviceStillPresent)
-        {
-            midiDevicesList.remove(i);
-            midiDeviceToggles.remove(i);
-            midiChannelToggles.remove(i);
-        }
     }
 
-    updateMidiDeviceSelections();
+    TraceLog::record(TraceLog::EventType::drainEnd, 0, static_cast<juce::uint32>(numDrained));
 
-    DBG("Calling refreshSettingsWindow()");
-    juce::MessageManager::callAsync([this] { refreshSettingsWindow(); });
+    // Evicted notes vanish from anywhere on screen; don't bother tracking where
+    auto numEvicted = notes.getOverflowCounters().droppedOldest + notes.getOverflowCounters().droppedQuietest - numEvictedBefore;
+    if (numEvicted > 0)
+    {
+        TraceLog::record(TraceLog::EventType::noteEvicted, 0, static_cast<juce::uint32>(numEvicted));
+        dirtyRegions.markAll();
+    }
 
-    DBG("Finished refreshMidiInputs()");
+    auto overflowCount = getMidiQueueOverflowCount();
+    if (overflowCount != lastReportedOverflowCount)
+    {
+        DBG("MIDI event queue overflow; total dropped: " + juce::String(overflowCount));
+        lastReportedOverflowCount = overflowCount;
+    }
+}
+
+juce::uint64 MainComponent::getMidiQueueOverflowCount() const noexcept
+{
+    juce::uint64 total = 0;
+    for (auto& slot : midiInputQueues)
+        total += slot.events.getNumOverflowed();
+
+    return total;
 }
 
 //==============================================================================
-void MainComponent::applyMidiSelections()
+void MainComponent::refreshMidiInputs()
+{
+    DBG("Requesting a MIDI device rescan");
+    deviceWatcher.rescan();
+}
+
+//==============================================================================
+void MainComponent::midiDevicesChanged(const juce::Array<juce::MidiDeviceInfo>& added, const juce::Array<juce::MidiDeviceInfo>& removed)
 {
-    // Close all currently open MIDI inputs
-    for (auto* device : midiInputsOpened)
+    StartupProfile::mark(StartupProfile::Milestone::devicesEnumerated);
+
+    // Unplugged devices: close their inputs but keep their registry entry and
+    // selection, so they come back the way they were if they're plugged in again
+    for (const auto& input : removed)
     {
-        device->stop();
+        DBG("MIDI input removed: " + input.name + " (ID: " + input.identifier + ")");
+
+        auto slot = midiDevices.deviceRemoved(input.identifier);
+        if (slot < 0)
+            continue;
+
+        closeMidiInput(midiDevices[slot]);
     }
-    midiInputsOpened.clear();
 
-    // Now open the newly selected MIDI inputs
+    for (const auto& input : added)
+    {
+        DBG("MIDI input added: " + input.name + " (ID: " + input.identifier + ")");
+
+        midiDevices.deviceAdded(input);
+    }
+
+    // Opens any returning devices that are still selected. The filter is republished
+    // as each one is bound in midiInputOpened(), and as removed ones finish closing.
     openSelectedMidiInputs();
+
+    if (numMidiInputsStarting == 0)
+        StartupProfile::mark(StartupProfile::Milestone::midiReady);
+
+    refreshSettingsWindow();
+}
+
+//==============================================================================
+void MainComponent::applyMidiSelections()
+{
+    // Inputs that stay selected keep their queue slot and stream straight through
+    // an Apply; a changed channel mask only swaps the filter snapshot under them.
+    // Opens for newly selected inputs are queued on the device worker ahead of
+    // the closes below.
+    openSelectedMidiInputs();
+
+    // Deselected inputs were already masked to nothing by the last published
+    // filter, so closing them now can't drop anything that would have been shown
+    int numClosed = 0;
+    for (int slot = 0; slot < midiDevices.getNumSlots(); ++slot)
+    {
+        auto& device = midiDevices[slot];
+        if (device.input != nullptr && !(device.present && device.selected))
+        {
+            DBG("Closing MIDI device: " + device.info.name);
+            closeMidiInput(device);
+            ++numClosed;
+        }
+    }
+
+    DBG("Applied MIDI selections; closed " + juce::String(numClosed) + " input(s)");
+}
+
+void MainComponent::closeMidiInput(MidiDeviceRegistry::Device& device)
+{
+    if (device.input == nullptr)
+        return;
+
+    // The queue stays bound until the input has stopped, as the MIDI thread may
+    // still be pushing into it
+    auto queueSlot = device.queueSlot;
+    device.queueSlot = -1;
+
+    midiDeviceWorker.closeDevice(std::move(device.input), [this, queueSlot] {
+        releaseMidiEventQueue(queueSlot);
+        publishMidiInputFilter();
+    });
 }
 
 //==============================================================================
@@ -342,14 +700,17 @@ void MainComponent::sliderValueChanged(juce::Slider* slider)
 {
     if (slider == &fadeRateSlider)
     {
-        fadeRate = static_cast<float>(fadeRateSlider.getValue());
+        updateRenderSettings([this](RenderSettings& settings) {
+            settings.fadeRate = static_cast<float>(fadeRateSlider.getValue());
+        });
+        saveSession();
     }
 }
 
 //==============================================================================
 void MainComponent::changeListenerCallback(juce::ChangeBroadcaster* source)
 {
-    if (source == &noteColorSelector)
+    if (source == noteColorSelector.get())
     {
         noteColorChanged();
     }
@@ -360,40 +721,8 @@ void MainComponent::buttonClicked(juce::Button* button)
 {
     DBG("Button clicked: " + button->getName());
 
-    // Check if the clicked button is one of our MIDI device or channel toggles
-    bool isMidiToggle = false;
-    for (auto* deviceToggle : midiDeviceToggles)
-    {
-        if (button == deviceToggle)
-        {
-            DBG("MIDI device toggle clicked: " + deviceToggle->getName());
-            isMidiToggle = true;
-            break;
-        }
-    }
-    if (!isMidiToggle)
-    {
-        for (auto* channelToggles : midiChannelToggles)
-        {
-            for (auto* channelToggle : *channelToggles)
-            {
-                if (button == channelToggle)
-                {
-                    DBG("MIDI channel toggle clicked: " + channelToggle->getName());
-                    isMidiToggle = true;
-                    break;
-                }
-            }
-            if (isMidiToggle) break;
-        }
-    }
-
-    if (isMidiToggle)
-    {
-        DBG("Updating MIDI device selections");
-        updateMidiDeviceSelections();
-    }
-    else if (button == &disableFadeToggle)
+    // Device and channel ticks are handled by the device list itself
+    if (button == &disableFadeToggle)
     {
         DBG("Fade toggle button clicked");
         fadeToggleChanged();
@@ -412,8 +741,12 @@ void MainComponent::buttonClicked(juce::Button* button)
     else if (button == &instantUpdateToggle)
     {
         DBG("Instant update toggle button clicked");
-        instantUpdateMode = instantUpdateToggle.getToggleState();
-        if (instantUpdateMode)
+        updateRenderSettings([this](RenderSettings& settings) {
+            settings.instantColourUpdate = instantUpdateToggle.getToggleState();
+        });
+        saveSession();
+
+        if (renderSettings.read()->instantColourUpdate)
         {
             repaint();
         }
@@ -435,117 +768,9 @@ void MainComponent::buttonClicked(juce::Button* button)
 //==============================================================================
 void MainComponent::refreshSettingsWindow()
 {
-    DBG("Starting refreshSettingsWindow()");
-    if (settingsWindow == nullptr)
-    {
-        DBG("Settings window is null, cannot refresh");
-        return;
-    }
-
-    try
-    {
-        auto* content = dynamic_cast<juce::Component*>(settingsWindow->getContentComponent());
-        if (content == nullptr)
-        {
-            DBG("Content is null, cannot refresh");
-            return;
-        }
-
-        DBG("Clearing existing content");
-        content->removeAllChildren();
-        ownedSettingsComponents.clear();
-
-        int yPos = 10;
-
-        auto addLabel = [&](const juce::String& text) {
-            auto label = std::make_unique<juce::Label>();
-            label->setText(text, juce::dontSendNotification);
-            label->setBounds(10, yPos, 380, 20);
-            content->addAndMakeVisible(label.get());
-            ownedSettingsComponents.add(label.release());
-            yPos += 25;
-        };
-
-        // MIDI Devices Section
-        addLabel("MIDI Devices:");
-
-        DBG("Refreshing MIDI device and channel toggles");
-        for (int i = 0; i < midiDeviceToggles.size(); ++i)
-        {
-            auto* deviceToggle = midiDeviceToggles[i];
-            deviceToggle->setBounds(10, yPos, 380, 20);
-            content->addAndMakeVisible(deviceToggle);
-            yPos += 25;
-
-            auto* channelToggles = midiChannelToggles[i];
-            for (int j = 0; j < channelToggles->size(); ++j)
-            {
-                auto* channelToggle = (*channelToggles)[j];
-                channelToggle->setBounds(30 + (j % 8) * 45, yPos, 40, 20);
-                content->addAndMakeVisible(channelToggle);
-
-                if (j % 8 == 7)
-                {
-                    yPos += 25;
-                }
-            }
-            yPos += 30;
-        }
-
-        // Scan and Apply Buttons
-        DBG("Adding Scan and Apply buttons");
-        scanButton.setBounds(10, yPos, 185, 30);
-        content->addAndMakeVisible(scanButton);
-        applyButton.setBounds(205, yPos, 185, 30);
-        content->addAndMakeVisible(applyButton);
-        yPos += 35;
-
-        // Fade Rate Slider
-        addLabel("Fade Rate:");
-        fadeRateSlider.setBounds(10, yPos, 380, 30);
-        content->addAndMakeVisible(fadeRateSlider);
-        yPos += 35;
-
-        // Disable Fade Toggle
-        DBG("Adding Disable Fade toggle");
-        disableFadeToggle.setBounds(10, yPos, 380, 30);
-        content->addAndMakeVisible(disableFadeToggle);
-        yPos += 35;
-
-        // Note Color Selector
-        addLabel("Note Color:");
-        noteColorSelector.setBounds(10, yPos, 380, 300);
-        content->addAndMakeVisible(noteColorSelector);
-        yPos += 305;
-
-        // Instant Update Toggle
-        DBG("Adding Instant Update toggle");
-        instantUpdateToggle.setBounds(10, yPos, 380, 30);
-        content->addAndMakeVisible(instantUpdateToggle);
-        yPos += 35;
-
-        // Mode Buttons
-        DBG("Adding Mode buttons");
-        enableMode1Button.setBounds(10, yPos, 185, 30);
-        content->addAndMakeVisible(enableMode1Button);
-        enableMode2Button.setBounds(205, yPos, 185, 30);
-        content->addAndMakeVisible(enableMode2Button);
-        yPos += 35;
-
-        DBG("Resizing content");
-        content->setSize(400, yPos);
-        settingsWindow->setContentComponentSize(400, yPos);
-
-        DBG("Refreshing settings window complete");
-    }
-    catch (const std::exception& e)
-    {
-        DBG("Exception in refreshSettingsWindow(): " + juce::String(e.what()));
-    }
-    catch (...)
-    {
-        DBG("Unknown exception in refreshSettingsWindow()");
-    }
+    // Everything else in the window is laid out once, in showSettingsWindow()
+    if (midiDeviceList != nullptr)
+        midiDeviceList->devicesChanged();
 }
 
 //==============================================================================
@@ -586,6 +811,24 @@ void MainComponent::showSettingsWindow()
     if (settingsWindow == nullptr)
     {
         DBG("Creating new settings window");
+
+        // Built on first use; the colour comes from the live render settings
+        if (noteColorSelector == nullptr)
+        {
+            noteColorSelector = std::make_unique<juce::ColourSelector>();
+            noteColorSelector->setCurrentColour(renderSettings.read()->noteColour, juce::dontSendNotification);
+            noteColorSelector->addChangeListener(this);
+        }
+
+        if (midiDeviceList == nullptr)
+        {
+            midiDeviceList = std::make_unique<MidiDeviceList>(midiDevices);
+            midiDeviceList->onSelectionChanged = [this](int slot) { midiDeviceSelectionChanged(slot); };
+        }
+
+        // The previous window's labels went away with its content
+        ownedSettingsComponents.clear();
+
         auto settingsContent = std::make_unique<juce::Component>();
         settingsContent->setColour(juce::ResizableWindow::backgroundColourId, juce::Colours::white);
 
@@ -603,6 +846,12 @@ void MainComponent::showSettingsWindow()
         // Add labels and other components here
         addLabel("MIDI Devices:");
 
+        // Three rows visible; the rest scroll
+        midiDeviceList->devicesChanged();
+        midiDeviceList->setBounds(10, yPos, 380, 3 * MidiDeviceList::rowHeight);
+        settingsContent->addAndMakeVisible(midiDeviceList.get());
+        yPos += 3 * MidiDeviceList::rowHeight + 5;
+
         // Add the scan button
         scanButton.setButtonText("Scan for MIDI Devices");
         scanButton.setBounds(10, yPos, 185, 30);
@@ -623,8 +872,8 @@ void MainComponent::showSettingsWindow()
         yPos += 35;
 
         addLabel("Note Color:");
-        noteColorSelector.setBounds(10, yPos, 380, 300);
-        settingsContent->addAndMakeVisible(noteColorSelector);
+        noteColorSelector->setBounds(10, yPos, 380, 300);
+        settingsContent->addAndMakeVisible(noteColorSelector.get());
         yPos += 305;
 
         // Instant Update Toggle
@@ -655,8 +904,6 @@ void MainComponent::showSettingsWindow()
         // Make the settings window visible
         settingsWindow->setVisible(true);
 
-        // Scan for MIDI devices/channels when the settings window is first created
-        refreshMidiInputs();
     }
     else
     {
@@ -677,79 +924,204 @@ void MainComponent::showSettingsWindow()
 //==============================================================================
 void MainComponent::updateMidiDeviceSelections()
 {
-    selectedMidiDevices.clear();
-    selectedChannels.clear();
-
-    for (int i = 0; i < midiDeviceToggles.size(); ++i)
+    // The device list writes selections straight into the registry
+    DBG("Selected MIDI Devices:");
+    for (int slot = 0; slot < midiDevices.getNumSlots(); ++slot)
     {
-        if (midiDeviceToggles[i]->getToggleState())
+        const auto& device = midiDevices[slot];
+        if (device.selected)
         {
-            selectedMidiDevices.add(midiDevicesList[i]);
-
-            auto* channelToggles = midiChannelToggles[i];
-            for (int j = 0; j < channelToggles->size(); ++j)
-            {
-                if ((*channelToggles)[j]->getToggleState())
-                {
-                    selectedChannels.add(j + 1);
-                }
-            }
+            DBG(" - " + device.info.name + " [" + device.info.identifier + "] (ticked channels 0x" + juce::String::toHexString(device.tickedChannels) + ")");
         }
     }
 
-    DBG("Selected MIDI Devices:");
-    for (const auto& device : selectedMidiDevices)
+    publishMidiInputFilter();
+    saveSession();
+}
+
+//==============================================================================
+void MainComponent::restoreSession()
+{
+    auto session = sessionStore.load();
+    if (!session.isValid())
+        return;
+
+    for (const auto& child : session)
     {
-        DBG(" - " + device);
+        if (child.hasType(SessionIds::device))
+        {
+            juce::MidiDeviceInfo info(child.getProperty(SessionIds::name).toString(), child.getProperty(SessionIds::identifier).toString());
+            midiDevices.deviceRestored(info, child.getProperty(SessionIds::selected, false),
+                                       static_cast<juce::uint16>(static_cast<int>(child.getProperty(SessionIds::channelMask, 0))));
+        }
     }
 
-    DBG("Selected Channels:");
-    for (const auto& channel : selectedChannels)
+    updateRenderSettings([&session](RenderSettings& settings) {
+        settings.fadeRate = static_cast<float>(static_cast<double>(session.getProperty(SessionIds::fadeRate, settings.fadeRate)));
+        settings.fadeEnabled = session.getProperty(SessionIds::fadeEnabled, settings.fadeEnabled);
+        settings.fadeShape = static_cast<int>(session.getProperty(SessionIds::fadeShape, 0)) == static_cast<int>(FadeEngine::Shape::linear)
+                                 ? FadeEngine::Shape::linear : FadeEngine::Shape::exponential;
+        settings.noteColour = juce::Colour::fromString(session.getProperty(SessionIds::noteColour, settings.noteColour.toString()).toString());
+        settings.instantColourUpdate = session.getProperty(SessionIds::instantColourUpdate, settings.instantColourUpdate);
+    });
+
+    // Controls follow the restored settings without echoing a save back
+    const auto& settings = *renderSettings.read();
+    fadeRateSlider.setValue(settings.fadeRate, juce::dontSendNotification);
+    disableFadeToggle.setToggleState(!settings.fadeEnabled, juce::dontSendNotification);
+    instantUpdateToggle.setToggleState(settings.instantColourUpdate, juce::dontSendNotification);
+
+    DBG("Restored session with " + juce::String(midiDevices.getNumSlots()) + " remembered MIDI device(s)");
+}
+
+void MainComponent::saveSession()
+{
+    // The tree is only built once the changes have settled
+    sessionStore.saveSoon();
+}
+
+juce::ValueTree MainComponent::createSessionState() const
+{
+    const auto& settings = *renderSettings.read();
+
+    juce::ValueTree session(SessionIds::session);
+    session.setProperty(SessionIds::fadeRate, settings.fadeRate, nullptr);
+    session.setProperty(SessionIds::fadeEnabled, settings.fadeEnabled, nullptr);
+    session.setProperty(SessionIds::fadeShape, static_cast<int>(settings.fadeShape), nullptr);
+    session.setProperty(SessionIds::noteColour, settings.noteColour.toString(), nullptr);
+    session.setProperty(SessionIds::instantColourUpdate, settings.instantColourUpdate, nullptr);
+
+    // Only selected devices are worth remembering, whether or not they're plugged in
+    for (int slot = 0; slot < midiDevices.getNumSlots(); ++slot)
     {
-        DBG(" - Channel " + juce::String(channel));
+        const auto& device = midiDevices[slot];
+        if (!device.selected)
+            continue;
+
+        juce::ValueTree child(SessionIds::device);
+        child.setProperty(SessionIds::identifier, device.info.identifier, nullptr);
+        child.setProperty(SessionIds::name, device.info.name, nullptr);
+        child.setProperty(SessionIds::selected, true, nullptr);
+        child.setProperty(SessionIds::channelMask, static_cast<int>(device.tickedChannels), nullptr);
+        session.appendChild(child, nullptr);
     }
+
+    return session;
 }
 
 //==============================================================================
-void MainComponent::fadeToggleChanged()
+void MainComponent::midiDeviceSelectionChanged(int deviceSlot)
 {
-    if (disableFadeToggle.getToggleState())
+    const auto& device = midiDevices[deviceSlot];
+    DBG("MIDI selection changed: " + device.info.name + (device.selected ? " on" : " off")
+        + " (ticked channels 0x" + juce::String::toHexString(device.tickedChannels) + ")");
+
+    // Only an open input has anything on the MIDI thread to update; the rest
+    // are picked up when Apply opens them
+    if (juce::isPositiveAndBelow(device.queueSlot, maxOpenMidiInputs))
     {
-        fadeRate = 0.0f;
+        auto filter = std::make_unique<MidiInputFilter>(*midiInputFilter.read());
+        filter->channelMasks[static_cast<size_t>(device.queueSlot)] = device.selected ? MidiInputFilter::maskForTickedChannels(device.tickedChannels) : juce::uint16(0);
+        midiInputFilter.publish(std::move(filter));
     }
-    else
+
+    saveSession();
+}
+
+//==============================================================================
+void MainComponent::publishMidiInputFilter()
+{
+    auto filter = std::make_unique<MidiInputFilter>();
+
+    for (int i = 0; i < maxOpenMidiInputs; ++i)
     {
-        fadeRate = static_cast<float>(fadeRateSlider.getValue());
+        const auto& slot = midiInputQueues[static_cast<size_t>(i)];
+
+        if (slot.synthetic)
+        {
+            filter->channelMasks[static_cast<size_t>(i)] = MidiInputFilter::allChannels;
+        }
+        else if (slot.deviceSlot >= 0 && slot.source.load(std::memory_order_relaxed) != nullptr)
+        {
+            // Each device only lets through the channels ticked in its own row
+            const auto& device = midiDevices[slot.deviceSlot];
+            if (device.selected)
+                filter->channelMasks[static_cast<size_t>(i)] = MidiInputFilter::maskForTickedChannels(device.tickedChannels);
+        }
     }
+
+    midiInputFilter.publish(std::move(filter));
+}
+
+//==============================================================================
+void MainComponent::fadeToggleChanged()
+{
+    updateRenderSettings([this](RenderSettings& settings) {
+        settings.fadeEnabled = !disableFadeToggle.getToggleState();
+    });
+    saveSession();
 }
 
 //==============================================================================
 void MainComponent::openSelectedMidiInputs()
 {
-    DBG("Opening selected MIDI inputs:");
-    for (const auto& deviceName : selectedMidiDevices)
+    for (int slot = 0; slot < midiDevices.getNumSlots(); ++slot)
     {
-        // Check if the device is already opened
-        bool isAlreadyOpened = std::any_of(midiInputsOpened.begin(), midiInputsOpened.end(),
-                                           [&](juce::MidiInput* input) { return input->getName() == deviceName; });
-        if (isAlreadyOpened)
+        auto& device = midiDevices[slot];
+        if (!device.present || !device.selected || device.input != nullptr || device.opening)
             continue;
 
-        auto availableDevices = juce::MidiInput::getAvailableDevices();
-        auto deviceInfo = std::ranges::find_if(availableDevices, [&](const auto& d) { return d.name == deviceName; });
+        DBG("Opening MIDI device: " + device.info.name);
+        device.opening = true;
+        ++numMidiInputsStarting;
 
-        if (deviceInfo != availableDevices.end())
-        {
-            if (auto midiInput = juce::MidiInput::openDevice(deviceInfo->identifier, this))
-            {
-                midiInputsOpened.add(midiInput.release());
-                midiInputsOpened.getLast()->start();
-                DBG("Opened and started MIDI device: " + deviceName);
-            }
-            else
-            {
-                DBG("Failed to open MIDI device: " + deviceName);
-            }
-        }
+        midiDeviceWorker.openDevice(device.info.identifier, this, [this, slot](std::unique_ptr<juce::MidiInput> input) {
+            midiInputOpened(slot, std::move(input));
+        });
     }
-}
\ No newline at end of file
+}
+
+void MainComponent::midiInputOpened(int slot, std::unique_ptr<juce::MidiInput> input)
+{
+    auto& device = midiDevices[slot];
+    device.opening = false;
+
+    if (input == nullptr)
+    {
+        DBG("Failed to open MIDI device: " + device.info.name);
+        midiInputSettled();
+        return;
+    }
+
+    // Deselected or unplugged while the open was in flight
+    if (!device.present || !device.selected || device.input != nullptr)
+    {
+        midiDeviceWorker.closeDevice(std::move(input));
+        midiInputSettled();
+        return;
+    }
+
+    device.queueSlot = bindMidiEventQueue(input.get(), slot);
+    if (device.queueSlot < 0)
+    {
+        DBG("No free MIDI event queue for device: " + device.info.name);
+        midiDeviceWorker.closeDevice(std::move(input));
+        midiInputSettled();
+        return;
+    }
+
+    device.input = std::move(input);
+
+    // The filter has to know about the new slot before the input can deliver messages
+    publishMidiInputFilter();
+
+    midiDeviceWorker.startDevice(device.input.get(), [this] { midiInputSettled(); });
+    DBG("Opened MIDI device: " + device.info.name);
+}
+
+void MainComponent::midiInputSettled()
+{
+    // Startup counts as MIDI-ready once every open queued so far has started or failed
+    if (--numMidiInputsStarting == 0)
+        StartupProfile::mark(StartupProfile::Milestone::midiReady);
+}
@@ -2,14 +2,33 @@
 
 #include <JuceHeader.h>
 #include "CustomLookAndFeel.h"
+#include "MidiEventQueue.h"
+#include "MidiInputFilter.h"
+#include "NotePool.h"
+#include "FadeEngine.h"
+#include "NoteDirtyRegions.h"
+#include "NoteRenderer.h"
+#include "RenderSettings.h"
+#include "LatencyHistogram.h"
+#include "PerformanceHud.h"
+#include "SyntheticMidiSource.h"
+#include "MidiDeviceWatcher.h"
+#include "MidiDeviceRegistry.h"
+#include "MidiDeviceList.h"
+#include "MidiDeviceWorker.h"
+#include "StartupProfile.h"
+#include "SessionStore.h"
+#include "AllocationTracker.h"
+#include "TraceLog.h"
+#include "SnapshotPublisher.h"
+#include <array>
 
 //==============================================================================
 class MainComponent : public juce::Component,
                       public juce::MidiInputCallback,
                       public juce::Slider::Listener,
                       public juce::ChangeListener,
-                      public juce::Button::Listener,
-                      private juce::Timer
+                      public juce::Button::Listener
 {
 public:
     MainComponent();
@@ -18,6 +37,7 @@ public:
     void initialize();
 
     void paint(juce::Graphics& g) override;
+    void paintOverChildren(juce::Graphics& g) override;
     void resized() override;
 
     void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
@@ -27,6 +47,35 @@ public:
 
     void showSettingsWindow();
 
+    // Number of MIDI events dropped because a per-input queue was full
+    juce::uint64 getMidiQueueOverflowCount() const noexcept;
+
+    // Live note storage; capacity and overflow policy can change at any time on the message thread
+    void setNoteCapacity(int capacity);
+    void setNoteOverflowPolicy(NotePool::OverflowPolicy policy);
+    void resetNoteOverflowCounters() noexcept { notes.resetOverflowCounters(); }
+    const NotePool& getNotePool() const noexcept { return notes; }
+
+    void setFadeShape(FadeEngine::Shape shape);
+
+    // Time from a note's MIDI timestamp to the end of the first paint that drew it
+    const LatencyHistogram& getNoteLatency() const noexcept { return noteLatency; }
+    void resetNoteLatency() noexcept { noteLatency.reset(); }
+
+    void setPerformanceHudVisible(bool shouldBeVisible);
+    bool isPerformanceHudVisible() const noexcept { return performanceHud.isVisible(); }
+
+    // Feeds generated MIDI through the same entry point as a real input, on slots of
+    // its own with every channel enabled. Returns false if no input slot was free.
+    bool startSyntheticMidi(const SyntheticMidiGenerator::Settings& settings);
+    void stopSyntheticMidi();
+    const SyntheticMidiGenerator::Settings* getSyntheticMidiSettings() const noexcept;
+
+    // Realtime-safety test: drives synthetic MIDI, lets the pipeline warm up, then
+    // fails if the MIDI callback or a frame allocates during the next 'seconds'.
+    // Needs a build with ILUMIDI_TRACK_ALLOCATIONS=1.
+    void runAllocationTest(double seconds, std::function<void(bool passed)> onFinished);
+
 private:
     // Inner class to handle the close button of the settings window
     class SettingsWindowCloseButtonHandler;
@@ -35,12 +84,44 @@ private:
 
     // Methods for MIDI device selection
     void refreshMidiInputs();
+    void midiDevicesChanged(const juce::Array<juce::MidiDeviceInfo>& added, const juce::Array<juce::MidiDeviceInfo>& removed);
     void refreshSettingsWindow();
     void openSelectedMidiInputs();
+    void midiInputOpened(int slot, std::unique_ptr<juce::MidiInput> input);
+    void midiInputSettled();
+    void startMidiDeviceSetup();
     void applyMidiSelections();
+    void closeMidiInput(MidiDeviceRegistry::Device& device);
     void updateMidiDeviceSelections();
-    void processMidiMessage(const juce::MidiMessage& message);
-    void timerCallback() override;
+    void midiDeviceSelectionChanged(int deviceSlot);
+    void publishMidiInputFilter();
+
+    // Devices, channel masks and render settings, restored at launch and saved on change
+    void restoreSession();
+    void saveSession();
+    juce::ValueTree createSessionState() const;
+    void processMidiMessage(const MidiEvent& event, int inputSlot, juce::uint64 noteId);
+    void onVBlank();
+    void applyRenderSettings();
+    void advanceAnimation();
+    void refreshPerformanceHud(double nowMs);
+
+    // Copies the live settings, lets change() edit them and publishes the result
+    template <typename Change>
+    void updateRenderSettings(Change&& change)
+    {
+        auto next = std::make_unique<RenderSettings>(*renderSettings.read());
+        change(*next);
+        ++next->version;
+        renderSettings.publish(std::move(next));
+    }
+
+    // Per-input event queues (MIDI thread -> message thread)
+    void pushMidiMessage(int slot, const juce::MidiMessage& message) noexcept;
+    int findMidiInputSlot(juce::MidiInput* source) const noexcept;
+    int bindMidiEventQueue(juce::MidiInput* source, int deviceSlot);
+    void releaseMidiEventQueue(int queueSlot);
+    void drainMidiEventQueues();
 
     // **Added missing method declarations**
     void noteColorChanged();
@@ -50,12 +131,8 @@ private:
     juce::Slider fadeRateSlider;
     juce::ToggleButton disableFadeToggle;
     juce::TextButton scanButton;
-    juce::ColourSelector noteColorSelector;
-    juce::StringArray midiDevicesList;
-    juce::Array<juce::String> selectedMidiDevices;
-    juce::Array<int> selectedChannels;
-    juce::OwnedArray<juce::ToggleButton> midiDeviceToggles;
-    juce::OwnedArray<juce::OwnedArray<juce::ToggleButton>> midiChannelToggles;
+    std::unique_ptr<juce::ColourSelector> noteColorSelector; // built when the settings window first opens
+    std::unique_ptr<MidiDeviceList> midiDeviceList; // built when the settings window first opens
     juce::TextButton applyButton;
 
     juce::ToggleButton instantUpdateToggle;
@@ -64,20 +141,68 @@ private:
     juce::TextButton enableMode1Button;
     juce::TextButton enableMode2Button;
 
-    float fadeRate;
-    juce::Colour noteColor;
-
     CustomLookAndFeel customLookAndFeel;
-    bool instantUpdateMode;
 
-    // MIDI data storage
-    std::vector<std::pair<juce::MidiMessage, float>> midiMessages;
-
-    // **Added missing variable declaration**
-    juce::OwnedArray<juce::MidiInput> midiInputsOpened;
+    // Fade, colour and display mode, shared with the render step without locks
+    SnapshotPublisher<RenderSettings> renderSettings;
+    juce::uint32 appliedRenderSettingsVersion = 0;
+
+    // Live notes, decoded once on ingestion, and the clock that fades them
+    NotePool notes;
+    FadeEngine fadeEngine;
+    double lastAnimationTime = 0.0;
+    juce::uint32 lastFadePhase = 0;
+    NoteDirtyRegions dirtyRegions;
+    NoteRenderer noteRenderer;
+
+    // Pool sequence number of the first note no paint has drawn yet. Evicting a
+    // quiet note shifts the ring, so this can't be a count from the newest end.
+    juce::uint64 firstUnpaintedNote = 0;
+    LatencyHistogram noteLatency;
+
+    // Diagnostics overlay and the counters it samples
+    PerformanceHud performanceHud;
+    juce::uint64 numNotesIngested = 0;
+    int peakQueueDepth = 0;    // fullest any input queue was when drained, since the last refresh
+
+    // Every device seen this session, with its selection and opened input
+    MidiDeviceRegistry midiDevices;
+    SessionStore sessionStore;
+
+    // One queue per opened input, preallocated so the MIDI thread never allocates.
+    // A slot is claimed before MidiInput::start() and released after stop().
+    static constexpr int maxOpenMidiInputs = MidiInputFilter::maxSlots;
+
+    struct MidiInputQueue
+    {
+        std::atomic<juce::MidiInput*> source { nullptr };
+        bool synthetic = false; // claimed by syntheticMidi; message thread only
+        int deviceSlot = -1;    // registry slot of the bound input; message thread only
+        MidiEventQueue events;
+    };
+
+    std::array<MidiInputQueue, maxOpenMidiInputs> midiInputQueues;
+    std::atomic<bool> framePending { false }; // set by the MIDI thread, cleared by onVBlank()
+    SnapshotPublisher<MidiInputFilter> midiInputFilter;
+    juce::uint64 lastReportedOverflowCount = 0;
+
+    // Declared after the queues and filter it pushes into, so it stops first
+    std::unique_ptr<SyntheticMidiPlayer> syntheticMidi;
+
+    // Enumerates devices off the message thread; destroyed before the inputs it reports on
+    MidiDeviceWatcher deviceWatcher;
+
+    // Opens, starts, stops and closes inputs off the message thread, in order
+    MidiDeviceWorker midiDeviceWorker;
+    int numMidiInputsStarting = 0;      // opens queued that haven't started or failed yet
+    bool midiDeviceSetupStarted = false;   // by the first vblank after the first paint, or midiDeviceSetupDelayMs after initialize()
+    static constexpr int midiDeviceSetupDelayMs = 250;
 
     // **Added OwnedArray to manage dynamically created components**
     juce::OwnedArray<juce::Component> ownedSettingsComponents;
 
+    // Frame loop, paced by the display this component is on
+    juce::VBlankAttachment vBlankAttachment;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
 };
\ No newline at end of file
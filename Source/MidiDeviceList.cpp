@@ -0,0 +1,146 @@
+#include "MidiDeviceList.h"
+#include <array>
+
+//==============================================================================
+class MidiDeviceList::Row : public juce::Component
+{
+public:
+    explicit Row(MidiDeviceList& ownerList)
+        : owner(ownerList)
+    {
+        styleToggle(deviceToggle);
+        deviceToggle.onClick = [this] { owner.deviceToggled(slot, deviceToggle.getToggleState()); };
+        addAndMakeVisible(deviceToggle);
+
+        for (int i = 0; i < 16; ++i)
+        {
+            auto& channelToggle = channelToggles[static_cast<size_t>(i)];
+            channelToggle.setButtonText("Ch " + juce::String(i + 1));
+            styleToggle(channelToggle);
+            channelToggle.onClick = [this, i] { owner.channelToggled(slot, i); };
+            addAndMakeVisible(channelToggle);
+        }
+    }
+
+    // Recycled rows are simply pointed at another device
+    void bind(int newSlot, const MidiDeviceRegistry::Device& device)
+    {
+        slot = newSlot;
+        deviceToggle.setButtonText(device.info.name);
+        deviceToggle.setToggleState(device.selected, juce::dontSendNotification);
+
+        for (int i = 0; i < 16; ++i)
+            channelToggles[static_cast<size_t>(i)].setToggleState((device.tickedChannels & (1u << i)) != 0, juce::dontSendNotification);
+    }
+
+    void resized() override
+    {
+        deviceToggle.setBounds(0, 0, getWidth(), 20);
+
+        for (int i = 0; i < 16; ++i)
+            channelToggles[static_cast<size_t>(i)].setBounds(20 + (i % 8) * 45, 25 + (i / 8) * 25, 40, 20);
+    }
+
+private:
+    static void styleToggle(juce::ToggleButton& toggle)
+    {
+        toggle.setColour(juce::ToggleButton::textColourId, juce::Colours::black);
+        toggle.setColour(juce::ToggleButton::tickDisabledColourId, juce::Colours::black);
+        toggle.setColour(juce::ToggleButton::tickColourId, juce::Colours::black);
+    }
+
+    MidiDeviceList& owner;
+    int slot = -1;  // rebound whenever the ListBox recycles the row
+    juce::ToggleButton deviceToggle;
+    std::array<juce::ToggleButton, 16> channelToggles;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Row)
+};
+
+//==============================================================================
+MidiDeviceList::MidiDeviceList(MidiDeviceRegistry& deviceRegistry)
+    : registry(deviceRegistry)
+{
+    listBox.setModel(this);
+    listBox.setRowHeight(rowHeight);
+    addAndMakeVisible(listBox);
+
+    devicesChanged();
+}
+
+MidiDeviceList::~MidiDeviceList()
+{
+    listBox.setModel(nullptr);
+}
+
+void MidiDeviceList::devicesChanged()
+{
+    std::vector<int> presentSlots;
+    for (int slot = 0; slot < registry.getNumSlots(); ++slot)
+        if (registry[slot].present)
+            presentSlots.push_back(slot);
+
+    if (presentSlots == rowSlots)
+        return;
+
+    rowSlots = std::move(presentSlots);
+    listBox.updateContent();
+}
+
+void MidiDeviceList::resized()
+{
+    listBox.setBounds(getLocalBounds());
+}
+
+//==============================================================================
+int MidiDeviceList::getNumRows()
+{
+    return static_cast<int>(rowSlots.size());
+}
+
+void MidiDeviceList::paintListBoxItem(int, juce::Graphics&, int, int, bool)
+{
+    // Rows are components
+}
+
+juce::Component* MidiDeviceList::refreshComponentForRow(int rowNumber, bool, juce::Component* existingComponentToUpdate)
+{
+    if (!juce::isPositiveAndBelow(rowNumber, getNumRows()))
+    {
+        delete existingComponentToUpdate;
+        return nullptr;
+    }
+
+    auto* row = dynamic_cast<Row*>(existingComponentToUpdate);
+    if (row == nullptr)
+    {
+        delete existingComponentToUpdate;
+        row = new Row(*this);
+    }
+
+    auto slot = rowSlots[static_cast<size_t>(rowNumber)];
+    row->bind(slot, registry[slot]);
+    return row;
+}
+
+void MidiDeviceList::deviceToggled(int slot, bool isSelected)
+{
+    if (!juce::isPositiveAndBelow(slot, registry.getNumSlots()))
+        return;
+
+    registry[slot].selected = isSelected;
+
+    if (onSelectionChanged != nullptr)
+        onSelectionChanged(slot);
+}
+
+void MidiDeviceList::channelToggled(int slot, int channel)
+{
+    if (!juce::isPositiveAndBelow(slot, registry.getNumSlots()))
+        return;
+
+    registry[slot].tickedChannels ^= static_cast<juce::uint16>(1u << channel);
+
+    if (onSelectionChanged != nullptr)
+        onSelectionChanged(slot);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "MidiDeviceRegistry.h"
+#include <functional>
+#include <vector>
+
+//==============================================================================
+// The device/channel matrix of the settings window as a virtualised ListBox:
+// one row per present device, with row components recycled by the ListBox so
+// only the visible rows exist. The ticks are read from and written straight to
+// the registry's selected flag and ticked channels; the rows hold no state.
+class MidiDeviceList : public juce::Component,
+                       private juce::ListBoxModel
+{
+public:
+    static constexpr int rowHeight = 80;
+
+    explicit MidiDeviceList(MidiDeviceRegistry& registry);
+    ~MidiDeviceList() override;
+
+    // Called after a tick has changed one device's selected flag or ticked channels
+    // in the registry
+    std::function<void(int slot)> onSelectionChanged;
+
+    // Picks up devices that appeared or went away. Nothing is rebuilt if the
+    // set of present devices didn't change, and otherwise only visible rows are.
+    void devicesChanged();
+
+    void resized() override;
+
+private:
+    class Row;
+
+    int getNumRows() override;
+    void paintListBoxItem(int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+    juce::Component* refreshComponentForRow(int rowNumber, bool isRowSelected, juce::Component* existingComponentToUpdate) override;
+
+    void deviceToggled(int slot, bool isSelected);
+    void channelToggled(int slot, int channel);
+
+    MidiDeviceRegistry& registry;
+    std::vector<int> rowSlots;  // registry slot shown in each row
+    juce::ListBox listBox;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiDeviceList)
+};
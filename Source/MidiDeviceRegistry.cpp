@@ -0,0 +1,49 @@
+#include "MidiDeviceRegistry.h"
+
+//==============================================================================
+int MidiDeviceRegistry::deviceAdded(const juce::MidiDeviceInfo& info)
+{
+    auto [it, isNew] = slotsByIdentifier.try_emplace(info.identifier, getNumSlots());
+
+    if (isNew)
+        devices.emplace_back();
+
+    auto& device = devices[static_cast<size_t>(it->second)];
+    device.info = info;  // the name can change between connections
+    device.present = true;
+
+    return it->second;
+}
+
+int MidiDeviceRegistry::deviceRestored(const juce::MidiDeviceInfo& info, bool selected, juce::uint16 tickedChannels)
+{
+    auto [it, isNew] = slotsByIdentifier.try_emplace(info.identifier, getNumSlots());
+
+    if (isNew)
+    {
+        devices.emplace_back();
+        devices.back().info = info;
+    }
+
+    auto& device = devices[static_cast<size_t>(it->second)];
+    device.selected = selected;
+    device.tickedChannels = tickedChannels;
+
+    return it->second;
+}
+
+int MidiDeviceRegistry::deviceRemoved(const juce::String& identifier)
+{
+    auto slot = findSlot(identifier);
+
+    if (slot >= 0)
+        devices[static_cast<size_t>(slot)].present = false;
+
+    return slot;
+}
+
+int MidiDeviceRegistry::findSlot(const juce::String& identifier) const noexcept
+{
+    auto it = slotsByIdentifier.find(identifier);
+    return it != slotsByIdentifier.end() ? it->second : -1;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "MidiInputFilter.h"
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+// Every MIDI input seen this session, keyed by MidiDeviceInfo::identifier. Each
+// device gets a slot index the first time it appears and keeps it for the rest
+// of the session, including while it's unplugged, so two controllers with the
+// same name never collide and the settings UI can address devices by slot.
+// Message thread only.
+class MidiDeviceRegistry
+{
+public:
+    struct Device
+    {
+        juce::MidiDeviceInfo info;
+        bool present = false;
+        bool selected = false;
+        juce::uint16 tickedChannels = 0;    // bit (channel - 1), exactly as ticked; 0 = none ticked
+
+        // Open while non-null, bound to midiInputQueues[queueSlot] in MainComponent
+        std::unique_ptr<juce::MidiInput> input;
+        int queueSlot = -1;
+        bool opening = false;   // open queued on the device worker
+    };
+
+    // Returns the device's slot, reusing the one it had if it's been seen before
+    int deviceAdded(const juce::MidiDeviceInfo& info);
+
+    // A device remembered from the last session: known, but absent until the
+    // watcher reports it. Returns its slot.
+    int deviceRestored(const juce::MidiDeviceInfo& info, bool selected, juce::uint16 tickedChannels);
+
+    // Marks the device absent and returns its slot, or -1 if it was never seen
+    int deviceRemoved(const juce::String& identifier);
+
+    int findSlot(const juce::String& identifier) const noexcept;
+    int getNumSlots() const noexcept { return static_cast<int>(devices.size()); }
+
+    Device& operator[](int slot) noexcept               { return devices[static_cast<size_t>(slot)]; }
+    const Device& operator[](int slot) const noexcept   { return devices[static_cast<size_t>(slot)]; }
+
+private:
+    std::vector<Device> devices;
+    std::unordered_map<juce::String, int> slotsByIdentifier;
+};
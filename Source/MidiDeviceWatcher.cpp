@@ -0,0 +1,97 @@
+#include "MidiDeviceWatcher.h"
+#include <unordered_set>
+
+//==============================================================================
+MidiDeviceWatcher::MidiDeviceWatcher(Callback onDevicesChanged)
+    : juce::Thread("iLumidi MIDI device watcher"), callback(std::move(onDevicesChanged))
+{
+}
+
+MidiDeviceWatcher::~MidiDeviceWatcher()
+{
+    connection = {};
+    stopThread(2000);
+    cancelPendingUpdate();
+}
+
+void MidiDeviceWatcher::start()
+{
+    // Called on the message thread whenever the OS adds or removes a MIDI device
+    connection = juce::MidiDeviceListConnection::make([this] { rescan(); });
+
+   #if ! JUCE_MAC
+    startThread(juce::Thread::Priority::low);
+   #endif
+
+    rescan();
+}
+
+void MidiDeviceWatcher::rescan()
+{
+   #if JUCE_MAC
+    {
+        auto available = juce::MidiInput::getAvailableDevices();
+
+        const juce::ScopedLock sl(latestLock);
+        latest = std::move(available);
+    }
+
+    triggerAsyncUpdate();
+   #else
+    scanRequested.store(true, std::memory_order_release);
+    notify();
+   #endif
+}
+
+//==============================================================================
+void MidiDeviceWatcher::run()
+{
+    while (!threadShouldExit())
+    {
+        if (!scanRequested.exchange(false, std::memory_order_acquire))
+        {
+            wait(-1);
+            continue;
+        }
+
+        auto available = juce::MidiInput::getAvailableDevices();
+
+        {
+            const juce::ScopedLock sl(latestLock);
+            latest = std::move(available);
+        }
+
+        triggerAsyncUpdate();
+    }
+}
+
+void MidiDeviceWatcher::handleAsyncUpdate()
+{
+    juce::Array<juce::MidiDeviceInfo> current;
+    {
+        const juce::ScopedLock sl(latestLock);
+        current = latest;
+    }
+
+    std::unordered_set<juce::String> currentIds, knownIds;
+    for (const auto& device : current)
+        currentIds.insert(device.identifier);
+    for (const auto& device : devices)
+        knownIds.insert(device.identifier);
+
+    juce::Array<juce::MidiDeviceInfo> added, removed;
+    for (const auto& device : current)
+        if (knownIds.count(device.identifier) == 0)
+            added.add(device);
+    for (const auto& device : devices)
+        if (currentIds.count(device.identifier) == 0)
+            removed.add(device);
+
+    devices = std::move(current);
+
+    if ((!hasReported || !added.isEmpty() || !removed.isEmpty()) && callback != nullptr)
+    {
+        hasReported = true;
+        callback(added, removed);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+// Keeps track of the available MIDI inputs. JUCE's device-list notification (or
+// an explicit rescan) wakes a background thread that calls
+// MidiInput::getAvailableDevices(), which can block for hundreds of milliseconds
+// on some systems. On macOS CoreMIDI has to be enumerated on the message thread
+// (JUCE asserts it), and is cheap there, so the scan runs inline instead and no
+// thread is started. Either way the result is diffed against the last list
+// delivered, by identifier, and only the added and removed devices are handed to
+// onDevicesChanged on the message thread. The first enumeration is always
+// reported, even if it found nothing.
+class MidiDeviceWatcher : private juce::Thread,
+                          private juce::AsyncUpdater
+{
+public:
+    using Callback = std::function<void(const juce::Array<juce::MidiDeviceInfo>& added,
+                                        const juce::Array<juce::MidiDeviceInfo>& removed)>;
+
+    explicit MidiDeviceWatcher(Callback onDevicesChanged);
+    ~MidiDeviceWatcher() override;
+
+    // Subscribes to device-list changes and runs the first enumeration
+    void start();
+
+    // Enumerates again even if the system hasn't reported a change
+    void rescan();
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    Callback callback;
+    juce::MidiDeviceListConnection connection;
+    std::atomic<bool> scanRequested { false };
+
+    juce::CriticalSection latestLock;
+    juce::Array<juce::MidiDeviceInfo> latest;   // newest enumeration, written by the watcher thread
+    juce::Array<juce::MidiDeviceInfo> devices;  // what the message thread has been told about
+    bool hasReported = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiDeviceWatcher)
+};
@@ -0,0 +1,119 @@
+#include "MidiDeviceWorker.h"
+
+//==============================================================================
+MidiDeviceWorker::MidiDeviceWorker()
+    : juce::Thread("iLumidi MIDI device worker")
+{
+    startThread(juce::Thread::Priority::normal);
+}
+
+MidiDeviceWorker::~MidiDeviceWorker()
+{
+    finish();
+}
+
+void MidiDeviceWorker::finish()
+{
+    // A stuck driver gets a few seconds before the thread is abandoned
+    signalThreadShouldExit();
+    notify();
+    stopThread(4000);
+
+    cancelPendingUpdate();
+
+    const juce::ScopedLock sl(lock);
+    completed.clear();
+}
+
+//==============================================================================
+void MidiDeviceWorker::post(std::function<void()> work, std::function<void()> onDone)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        pending.push_back({ std::move(work), std::move(onDone) });
+    }
+
+    notify();
+}
+
+void MidiDeviceWorker::openDevice(const juce::String& identifier, juce::MidiInputCallback* callback, OpenCallback onOpened)
+{
+    auto result = std::make_shared<std::unique_ptr<juce::MidiInput>>();
+
+    post([result, identifier, callback] { *result = juce::MidiInput::openDevice(identifier, callback); },
+         [result, onOpened = std::move(onOpened)] { onOpened(std::move(*result)); });
+}
+
+void MidiDeviceWorker::startDevice(juce::MidiInput* input, std::function<void()> onStarted)
+{
+    post([input] { input->start(); }, std::move(onStarted));
+}
+
+void MidiDeviceWorker::closeDevice(std::unique_ptr<juce::MidiInput> input, std::function<void()> onClosed)
+{
+    if (input == nullptr)
+        return;
+
+    auto toClose = std::make_shared<std::unique_ptr<juce::MidiInput>>(std::move(input));
+
+    post([toClose]
+         {
+             (*toClose)->stop();
+             toClose->reset();
+         },
+         std::move(onClosed));
+}
+
+//==============================================================================
+void MidiDeviceWorker::run()
+{
+    for (;;)
+    {
+        Job job;
+
+        {
+            const juce::ScopedLock sl(lock);
+
+            if (!pending.empty())
+            {
+                job = std::move(pending.front());
+                pending.pop_front();
+            }
+        }
+
+        if (job.work == nullptr)
+        {
+            // Only exit once the queue is empty, so inputs are always stopped
+            if (threadShouldExit())
+                return;
+
+            wait(-1);
+            continue;
+        }
+
+        job.work();
+
+        if (job.onDone != nullptr)
+        {
+            {
+                const juce::ScopedLock sl(lock);
+                completed.push_back(std::move(job.onDone));
+            }
+
+            triggerAsyncUpdate();
+        }
+    }
+}
+
+void MidiDeviceWorker::handleAsyncUpdate()
+{
+    std::deque<std::function<void()>> toCall;
+
+    {
+        const juce::ScopedLock sl(lock);
+        toCall.swap(completed);
+    }
+
+    for (auto& onDone : toCall)
+        onDone();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <deque>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+// Runs MIDI device open/start/stop/close on a dedicated thread, one job at a
+// time in the order they were posted, so a slow or stuck driver never blocks
+// the message thread or the frame loop. Each job can carry a completion that is
+// called back on the message thread once the job has run; completions are
+// delivered in posting order too.
+//
+// Because jobs are strictly ordered, a raw MidiInput pointer handed to a later
+// job stays valid as long as the job that deletes it was posted after it.
+class MidiDeviceWorker : private juce::Thread,
+                         private juce::AsyncUpdater
+{
+public:
+    using OpenCallback = std::function<void(std::unique_ptr<juce::MidiInput>)>;
+
+    MidiDeviceWorker();
+    ~MidiDeviceWorker() override;
+
+    // 'work' runs on the worker thread, then 'onDone' (if any) on the message thread
+    void post(std::function<void()> work, std::function<void()> onDone = {});
+
+    // onOpened receives nullptr if the device couldn't be opened
+    void openDevice(const juce::String& identifier, juce::MidiInputCallback* callback, OpenCallback onOpened);
+    void startDevice(juce::MidiInput* input, std::function<void()> onStarted = {});
+
+    // Stops and deletes the input; once onClosed is called it will deliver nothing more
+    void closeDevice(std::unique_ptr<juce::MidiInput> input, std::function<void()> onClosed = {});
+
+    // Runs whatever is still queued, then stops the thread. Pending completions
+    // are discarded, so the owner can call this from its destructor.
+    void finish();
+
+private:
+    struct Job
+    {
+        std::function<void()> work;
+        std::function<void()> onDone;
+    };
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    juce::CriticalSection lock;
+    std::deque<Job> pending;            // posted, not run yet
+    std::deque<std::function<void()>> completed;  // run, waiting for the message thread
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiDeviceWorker)
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+// A short MIDI message copied off the MIDI input thread. Only channel voice and
+// system common/realtime messages (three bytes or fewer) are queued; SysEx never
+// reaches the renderer so it is dropped at the door.
+struct MidiEvent
+{
+    double timestamp = 0.0;
+    juce::uint8 data[3] {};
+    juce::uint8 size = 0;
+    juce::uint32 sequence = 0;  // push() call that queued it, counting the ones that were dropped
+};
+
+//==============================================================================
+// Wait-free single-producer/single-consumer queue between one juce::MidiInput
+// callback (producer) and the render side (consumer). Storage is allocated once
+// up front, so push() never allocates or locks.
+class MidiEventQueue
+{
+public:
+    static constexpr int defaultCapacity = 4096;
+
+    explicit MidiEventQueue(int capacity = defaultCapacity)
+        : fifo(capacity), buffer(static_cast<size_t>(capacity))
+    {
+    }
+
+    // Producer side (MIDI input thread). Returns false if the message was dropped.
+    // Every call takes the next sequence number, queued or not.
+    bool push(const juce::MidiMessage& message) noexcept
+    {
+        auto sequence = nextSequence++;
+        auto numBytes = message.getRawDataSize();
+        if (numBytes <= 0 || numBytes > 3)
+            return false;
+
+        auto scope = fifo.write(1);
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+        {
+            numOverflowed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        auto& event = buffer[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+        event.timestamp = message.getTimeStamp();
+        event.size = static_cast<juce::uint8>(numBytes);
+        event.sequence = sequence;
+        std::memcpy(event.data, message.getRawData(), static_cast<size_t>(numBytes));
+        return true;
+    }
+
+    // Consumer side. Calls callback(const MidiEvent&) for everything currently queued
+    // and returns the number of events handed over.
+    template <typename Callback>
+    int drain(Callback&& callback)
+    {
+        auto scope = fifo.read(fifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            callback(buffer[static_cast<size_t>(scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            callback(buffer[static_cast<size_t>(scope.startIndex2 + i)]);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    // Only safe while neither side is running, e.g. before MidiInput::start() or after stop().
+    void reset() noexcept
+    {
+        fifo.reset();
+    }
+
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+    int getCapacity() const noexcept { return fifo.getTotalSize() - 1; }
+
+    juce::uint64 getNumOverflowed() const noexcept { return numOverflowed.load(std::memory_order_relaxed); }
+
+    // Producer side: the sequence number the next push() will take, so the producer
+    // can name an event before handing it over. Drained events carry theirs in
+    // MidiEvent::sequence.
+    juce::uint32 getNextSequence() const noexcept { return nextSequence; }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<MidiEvent> buffer;
+
+    std::atomic<juce::uint64> numOverflowed { 0 };
+    juce::uint32 nextSequence = 0;  // producer only; kept across reset() so ids stay unique
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiEventQueue)
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+// Compiled device/channel selection, indexed by MIDI input slot. Built on the
+// message thread whenever toggles or opened inputs change and published through
+// a SnapshotPublisher, so the MIDI callback only needs one load and one bit test.
+struct MidiInputFilter
+{
+    static constexpr int maxSlots = 16;
+    static constexpr juce::uint16 allChannels = 0xffff;
+
+    // Bit (channel - 1) set = channel accepted; 0 = slot closed or device deselected
+    std::array<juce::uint16, maxSlots> channelMasks {};
+
+    // A device with no channel ticked passes all of them
+    static juce::uint16 maskForTickedChannels(juce::uint16 tickedChannels) noexcept
+    {
+        return tickedChannels == 0 ? allChannels : tickedChannels;
+    }
+
+    // Channel is 1-16; system messages (channel 0) never reach the renderer
+    bool accepts(int slot, int channel) const noexcept
+    {
+        return juce::isPositiveAndBelow(channel - 1, 16)
+            && (channelMasks[static_cast<size_t>(slot)] & (1u << (channel - 1))) != 0;
+    }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "NoteEvent.h"
+#include "NoteGeometry.h"
+#include "TraceLog.h"
+#include <array>
+
+//==============================================================================
+// Collects which keys changed during a frame and turns them into a few
+// repaint(Rectangle) calls. Notes on the same key share one column, sized by the
+// tallest note; neighbouring columns that overlap are merged. If the result would
+// cover most of the canvas anyway, a single full repaint is cheaper.
+class NoteDirtyRegions
+{
+public:
+    static constexpr float fullRepaintCoverage = 0.5f;
+
+    void markNote(const NoteEvent& note) noexcept
+    {
+        auto& velocity = maxVelocityByKey[note.noteNumber];
+        velocity = juce::jmax(velocity, static_cast<juce::uint8>(note.velocity));
+        anyDirty = true;
+    }
+
+    void markAll() noexcept { everythingDirty = true; }
+
+    bool isEmpty() const noexcept { return !anyDirty && !everythingDirty; }
+
+    // Issues the repaints for this frame and starts tracking the next one
+    void flush(juce::Component& component)
+    {
+        if (everythingDirty)
+        {
+            TraceLog::record(TraceLog::EventType::repaintRequested, 0, TraceLog::fullRepaint);
+            component.repaint();
+        }
+        else if (anyDirty)
+        {
+            auto width = component.getWidth();
+            auto height = component.getHeight();
+
+            std::array<juce::Rectangle<int>, 128> runs;
+            int numRuns = 0;
+            juce::int64 dirtyArea = 0;
+
+            for (int key = 0; key < 128; ++key)
+            {
+                auto velocity = maxVelocityByKey[static_cast<size_t>(key)];
+                if (velocity == 0)
+                    continue;
+
+                auto bounds = NoteGeometry::getBounds(key, velocity, width, height);
+
+                if (numRuns > 0 && runs[static_cast<size_t>(numRuns - 1)].getRight() >= bounds.getX())
+                    runs[static_cast<size_t>(numRuns - 1)] = runs[static_cast<size_t>(numRuns - 1)].getUnion(bounds);
+                else
+                    runs[static_cast<size_t>(numRuns++)] = bounds;
+            }
+
+            for (int i = 0; i < numRuns; ++i)
+                dirtyArea += static_cast<juce::int64>(runs[static_cast<size_t>(i)].getWidth()) * runs[static_cast<size_t>(i)].getHeight();
+
+            if (static_cast<float>(dirtyArea) > fullRepaintCoverage * static_cast<float>(width) * static_cast<float>(height))
+            {
+                TraceLog::record(TraceLog::EventType::repaintRequested, 0, TraceLog::fullRepaint);
+                component.repaint();
+            }
+            else
+            {
+                for (int i = 0; i < numRuns; ++i)
+                {
+                    auto& run = runs[static_cast<size_t>(i)];
+                    TraceLog::record(TraceLog::EventType::repaintRequested, 0, TraceLog::packRange(run.getX(), run.getWidth()));
+                    component.repaint(run);
+                }
+            }
+        }
+
+        maxVelocityByKey.fill(0);
+        anyDirty = everythingDirty = false;
+    }
+
+private:
+    std::array<juce::uint8, 128> maxVelocityByKey {};
+    bool anyDirty = false, everythingDirty = false;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "MidiEventQueue.h"
+#include <type_traits>
+
+//==============================================================================
+// A live note as the renderer sees it, decoded once when it leaves the MIDI
+// event queue. Eight bytes, trivially copyable, so a frame walks contiguous
+// memory without touching juce::MidiMessage.
+struct NoteEvent
+{
+    static constexpr juce::uint32 fadePhaseMask = 1023;
+
+    juce::uint32 timestamp;          // microseconds on the MIDI input clock; wraps after ~71 minutes
+    juce::uint32 noteNumber : 7;
+    juce::uint32 velocity   : 7;     // 1-127
+    juce::uint32 channel    : 4;     // 0-15
+    juce::uint32 inputSlot  : 4;     // input queue slot the note arrived on (not the device registry slot)
+    juce::uint32 fadePhase  : 10;    // fade clock at arrival, see FadeEngine
+    static juce::uint32 timestampFromSeconds(double seconds) noexcept
+    {
+        return static_cast<juce::uint32>(static_cast<juce::int64>(seconds * 1.0e6));
+    }
+
+    // Returns false for anything that isn't a note-on with a non-zero velocity
+    static bool fromMidiEvent(const MidiEvent& event, int inputSlot, juce::uint32 fadePhase, NoteEvent& note) noexcept
+    {
+        if (event.size != 3 || (event.data[0] & 0xf0) != 0x90 || event.data[2] == 0)
+            return false;
+
+        note.timestamp = timestampFromSeconds(event.timestamp);
+        note.noteNumber = event.data[1] & 0x7fu;
+        note.velocity = event.data[2] & 0x7fu;
+        note.channel = event.data[0] & 0x0fu;
+        note.inputSlot = static_cast<juce::uint32>(inputSlot) & 0x0fu;
+        note.fadePhase = fadePhase & fadePhaseMask;
+        return true;
+    }
+};
+
+static_assert(sizeof(NoteEvent) == 8, "NoteEvent should stay packed into eight bytes");
+static_assert(std::is_trivially_copyable_v<NoteEvent>);
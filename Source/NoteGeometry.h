@@ -0,0 +1,32 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Where a note's triangle lands inside the canvas. Shared by paint() and the
+// dirty-region tracking so the two can never disagree.
+namespace NoteGeometry
+{
+    constexpr float halfWidth = 10.0f;
+
+    inline float getCentreX(int noteNumber, float canvasWidth) noexcept
+    {
+        return canvasWidth * static_cast<float>(noteNumber) / 127.0f;
+    }
+
+    inline float getHeight(int velocity, float canvasHeight) noexcept
+    {
+        return canvasHeight * static_cast<float>(velocity) / 127.0f;
+    }
+
+    // Integer bounds with a pixel of slack for anti-aliasing
+    inline juce::Rectangle<int> getBounds(int noteNumber, int velocity, int canvasWidth, int canvasHeight) noexcept
+    {
+        auto x = getCentreX(noteNumber, static_cast<float>(canvasWidth));
+        auto top = static_cast<float>(canvasHeight) - getHeight(velocity, static_cast<float>(canvasHeight));
+
+        return juce::Rectangle<float>::leftTopRightBottom(x - halfWidth, top, x + halfWidth, static_cast<float>(canvasHeight))
+                   .getSmallestIntegerContainer()
+                   .expanded(1);
+    }
+}
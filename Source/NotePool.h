@@ -0,0 +1,216 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "NoteEvent.h"
+#include <limits>
+#include <vector>
+
+//==============================================================================
+// Preallocated ring of live notes, oldest first. Adding a note and evicting the
+// oldest one are O(1); nothing allocates after setCapacity(). Every note follows
+// the same fade from the moment it arrives (see FadeEngine), so notes also
+// expire oldest first and can be retired from the front. Each added note is
+// given the next sequence number, which stays with it wherever evictions move it.
+class NotePool
+{
+public:
+    enum class OverflowPolicy
+    {
+        dropOldest,     // O(1): make room by evicting the oldest note
+        dropQuietest,   // O(n): evict the softest-played note, oldest first on ties
+        refuse          // O(1): keep what's there and drop the new note
+    };
+
+    struct OverflowCounters
+    {
+        juce::uint64 droppedOldest = 0;
+        juce::uint64 droppedQuietest = 0;
+        juce::uint64 refused = 0;
+    };
+
+    static constexpr int defaultCapacity = 8192;
+    static constexpr int minCapacity = 16;
+    static constexpr int maxCapacity = 1 << 20;
+
+    explicit NotePool(int initialCapacity = defaultCapacity, OverflowPolicy policy = OverflowPolicy::dropOldest)
+        : overflowPolicy(policy)
+    {
+        setCapacity(initialCapacity);
+    }
+
+    // Reallocates; the newest notes are kept if the pool shrinks
+    void setCapacity(int newCapacity)
+    {
+        newCapacity = juce::jlimit(minCapacity, maxCapacity, newCapacity);
+
+        std::vector<NoteEvent> resized(static_cast<size_t>(newCapacity));
+        std::vector<juce::uint64> resizedSequences(static_cast<size_t>(newCapacity));
+        auto numToKeep = juce::jmin(numNotes, newCapacity);
+        for (int i = 0; i < numToKeep; ++i)
+        {
+            resized[static_cast<size_t>(i)] = at(numNotes - numToKeep + i);
+            resizedSequences[static_cast<size_t>(i)] = sequenceAt(numNotes - numToKeep + i);
+        }
+
+        storage = std::move(resized);
+        sequences = std::move(resizedSequences);
+        head = 0;
+        numNotes = numToKeep;
+    }
+
+    void setOverflowPolicy(OverflowPolicy newPolicy) noexcept { overflowPolicy = newPolicy; }
+    OverflowPolicy getOverflowPolicy() const noexcept { return overflowPolicy; }
+
+    // Returns false if the note was refused
+    bool add(const NoteEvent& note) noexcept
+    {
+        if (numNotes == getCapacity())
+        {
+            switch (overflowPolicy)
+            {
+                case OverflowPolicy::dropOldest:
+                    popOldest();
+                    ++counters.droppedOldest;
+                    break;
+
+                case OverflowPolicy::dropQuietest:
+                    removeAt(findQuietest());
+                    ++counters.droppedQuietest;
+                    break;
+
+                case OverflowPolicy::refuse:
+                    ++counters.refused;
+                    return false;
+            }
+        }
+
+        sequenceAt(numNotes) = nextSequence++;
+        at(numNotes++) = note;
+        return true;
+    }
+
+    // Calls callback(NoteEvent&) from oldest to newest over at most two contiguous runs
+    template <typename Callback>
+    void forEach(Callback&& callback)
+    {
+        auto firstRun = juce::jmin(numNotes, getCapacity() - head);
+
+        for (int i = 0; i < firstRun; ++i)
+            callback(storage[static_cast<size_t>(head + i)]);
+
+        for (int i = 0; i < numNotes - firstRun; ++i)
+            callback(storage[static_cast<size_t>(i)]);
+    }
+
+    template <typename Callback>
+    void forEach(Callback&& callback) const
+    {
+        auto firstRun = juce::jmin(numNotes, getCapacity() - head);
+
+        for (int i = 0; i < firstRun; ++i)
+            callback(storage[static_cast<size_t>(head + i)]);
+
+        for (int i = 0; i < numNotes - firstRun; ++i)
+            callback(storage[static_cast<size_t>(i)]);
+    }
+
+    // Sequence number the next added note will get
+    juce::uint64 getNextSequence() const noexcept { return nextSequence; }
+
+    // Calls callback(const NoteEvent&) for the live notes added at or after 'sequence',
+    // oldest of those first. Walks back from the newest, so it's cheap for recent ones.
+    template <typename Callback>
+    void forEachSince(juce::uint64 sequence, Callback&& callback) const
+    {
+        auto first = numNotes;
+        while (first > 0 && sequenceAt(first - 1) >= sequence)
+            --first;
+
+        for (int i = first; i < numNotes; ++i)
+            callback(at(i));
+    }
+
+    // Drops notes from the front for as long as isExpired(const NoteEvent&) holds
+    template <typename Predicate>
+    int removeExpired(Predicate&& isExpired)
+    {
+        int numRemoved = 0;
+        while (numNotes > 0 && isExpired(at(0)))
+        {
+            popOldest();
+            ++numRemoved;
+        }
+        return numRemoved;
+    }
+
+    void clear() noexcept { head = 0; numNotes = 0; }
+
+    int size() const noexcept { return numNotes; }
+    bool isEmpty() const noexcept { return numNotes == 0; }
+    int getCapacity() const noexcept { return static_cast<int>(storage.size()); }
+
+    const OverflowCounters& getOverflowCounters() const noexcept { return counters; }
+    void resetOverflowCounters() noexcept { counters = {}; }
+
+private:
+    size_t getPhysicalIndex(int index) const noexcept
+    {
+        auto physical = head + index;
+        if (physical >= getCapacity())
+            physical -= getCapacity();
+
+        return static_cast<size_t>(physical);
+    }
+
+    NoteEvent& at(int index) noexcept                       { return storage[getPhysicalIndex(index)]; }
+    const NoteEvent& at(int index) const noexcept           { return storage[getPhysicalIndex(index)]; }
+    juce::uint64& sequenceAt(int index) noexcept            { return sequences[getPhysicalIndex(index)]; }
+    juce::uint64 sequenceAt(int index) const noexcept       { return sequences[getPhysicalIndex(index)]; }
+
+    void popOldest() noexcept
+    {
+        if (++head == getCapacity())
+            head = 0;
+
+        --numNotes;
+    }
+
+    int findQuietest() noexcept
+    {
+        int quietest = 0;
+        auto lowest = std::numeric_limits<juce::uint32>::max();
+
+        for (int i = 0; i < numNotes; ++i)
+        {
+            auto velocity = static_cast<juce::uint32>(at(i).velocity);
+            if (velocity < lowest)
+            {
+                lowest = velocity;
+                quietest = i;
+            }
+        }
+
+        return quietest;
+    }
+
+    // Shifts the older notes up by one so the ring stays in arrival order
+    void removeAt(int index) noexcept
+    {
+        for (int i = index; i > 0; --i)
+        {
+            at(i) = at(i - 1);
+            sequenceAt(i) = sequenceAt(i - 1);
+        }
+
+        popOldest();
+    }
+
+    std::vector<NoteEvent> storage;
+    std::vector<juce::uint64> sequences;    // parallel to storage
+    juce::uint64 nextSequence = 0;
+    int head = 0, numNotes = 0;
+    OverflowPolicy overflowPolicy;
+    OverflowCounters counters;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NotePool)
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "NotePool.h"
+#include "FadeEngine.h"
+#include "NoteGeometry.h"
+#include <array>
+
+//==============================================================================
+// Draws the live notes. Glyph positions are flattened into lookup tables once per
+// canvas size, and each frame batches every visible note into one reused Path per
+// alpha level, so a frame costs a handful of fillPath() calls. The path storage is
+// kept between frames; the fills themselves still allocate inside the graphics
+// backend.
+class NoteRenderer
+{
+public:
+    static constexpr int numAlphaLevels = 64;
+
+    void setCanvasSize(int newWidth, int newHeight)
+    {
+        width = newWidth;
+        height = newHeight;
+
+        for (int i = 0; i < 128; ++i)
+        {
+            centreXByKey[static_cast<size_t>(i)] = NoteGeometry::getCentreX(i, static_cast<float>(width));
+            topByVelocity[static_cast<size_t>(i)] = static_cast<float>(height) - NoteGeometry::getHeight(i, static_cast<float>(height));
+        }
+    }
+
+    // Sorts the notes that touch clipBounds into the per-alpha paths
+    void batchNotes(juce::Rectangle<int> clip, const NotePool& notes, const FadeEngine& fade)
+    {
+        auto clipBounds = clip.toFloat();
+        auto bottom = static_cast<float>(height);
+
+        notes.forEach([&](const NoteEvent& note)
+        {
+            auto x = centreXByKey[note.noteNumber];
+            auto top = topByVelocity[note.velocity];
+
+            // Most frames only repaint a few dirty columns
+            if (x + NoteGeometry::halfWidth < clipBounds.getX() || x - NoteGeometry::halfWidth > clipBounds.getRight()
+                || top > clipBounds.getBottom())
+                return;
+
+            auto level = juce::roundToInt(fade.getAlpha(note) * (numAlphaLevels - 1));
+            batches[static_cast<size_t>(level)].addTriangle(x, top, x + NoteGeometry::halfWidth, bottom, x - NoteGeometry::halfWidth, bottom);
+        });
+    }
+
+    // Hands each non-empty batch to the graphics backend and empties it for the next frame
+    void fillBatches(juce::Graphics& g, juce::Colour colour)
+    {
+        for (int level = 1; level < numAlphaLevels; ++level)
+        {
+            auto& batch = batches[static_cast<size_t>(level)];
+            if (batch.isEmpty())
+                continue;
+
+            g.setColour(colour.withAlpha(static_cast<float>(level) / static_cast<float>(numAlphaLevels - 1)));
+            g.fillPath(batch);
+            batch.clear();
+        }
+
+        batches[0].clear();
+    }
+
+private:
+    int width = 0, height = 0;
+    std::array<float, 128> centreXByKey {}, topByVelocity {};
+    std::array<juce::Path, numAlphaLevels> batches;
+};
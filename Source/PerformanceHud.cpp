@@ -0,0 +1,129 @@
+#include "PerformanceHud.h"
+
+//==============================================================================
+namespace
+{
+    constexpr float graphCeilingMs = 50.0f;    // frame times above this are clipped to the top of the graph
+    constexpr float textHeight = 13.0f;
+
+    juce::String formatMicros(juce::uint32 micros)
+    {
+        return juce::String(static_cast<double>(micros) * 0.001, 1);
+    }
+}
+
+//==============================================================================
+PerformanceHud::PerformanceHud()
+    : font(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), textHeight, juce::Font::plain))
+{
+    graphBounds = bounds.toFloat().reduced(8.0f).removeFromBottom(48.0f);
+    graph.preallocateSpace(numFrameSamples * 3 + 8);
+}
+
+void PerformanceHud::setVisible(bool shouldBeVisible) noexcept
+{
+    visible = shouldBeVisible;
+
+    // Start from a clean window so stale samples from a previous session don't show
+    frameTimesMs.fill(0.0f);
+    lastFrameMs = lastRefreshMs = 0.0;
+    framesSinceRefresh = paintsSinceRefresh = 0;
+    paintMsTotal = paintMsMax = 0.0;
+}
+
+//==============================================================================
+void PerformanceHud::frameStarted(double nowMs) noexcept
+{
+    if (lastFrameMs > 0.0)
+    {
+        frameTimesMs[static_cast<size_t>(nextFrameSample)] = static_cast<float>(nowMs - lastFrameMs);
+        nextFrameSample = (nextFrameSample + 1) % numFrameSamples;
+    }
+
+    lastFrameMs = nowMs;
+    ++framesSinceRefresh;
+}
+
+void PerformanceHud::paintFinished(double paintMs) noexcept
+{
+    paintMsTotal += paintMs;
+    paintMsMax = juce::jmax(paintMsMax, paintMs);
+    ++paintsSinceRefresh;
+}
+
+//==============================================================================
+void PerformanceHud::refresh(const Stats& stats, double nowMs)
+{
+    auto elapsedSeconds = lastRefreshMs > 0.0 ? (nowMs - lastRefreshMs) * 0.001 : 0.0;
+    auto fps = elapsedSeconds > 0.0 ? framesSinceRefresh / elapsedSeconds : 0.0;
+    auto ingestRate = elapsedSeconds > 0.0 ? static_cast<double>(stats.notesIngested - lastNotesIngested) / elapsedSeconds : 0.0;
+    auto paintMsAverage = paintsSinceRefresh > 0 ? paintMsTotal / paintsSinceRefresh : 0.0;
+
+    auto frameMsMax = 0.0f;
+    for (auto frameMs : frameTimesMs)
+        frameMsMax = juce::jmax(frameMsMax, frameMs);
+
+    juce::StringArray lines;
+    lines.add("fps     " + juce::String(fps, 1) + "   worst frame " + juce::String(frameMsMax, 1) + " ms");
+    lines.add("paint   " + juce::String(paintMsAverage, 2) + " ms avg  " + juce::String(paintMsMax, 2) + " max");
+    lines.add("hud     " + juce::String(lastDrawMs, 3) + " ms");
+    lines.add("notes   " + juce::String(stats.liveNotes) + " / " + juce::String(stats.noteCapacity));
+    lines.add("ingest  " + juce::String(juce::roundToInt(ingestRate)) + " notes/s");
+    lines.add("queue   " + juce::String(stats.peakQueueDepth) + " events peak depth");
+    lines.add("drops   queue " + juce::String(stats.queueDrops) + "  pool " + juce::String(stats.poolDrops));
+    lines.add("latency p50 " + formatMicros(stats.latency.p50) + "  p99 " + formatMicros(stats.latency.p99) + " ms");
+    lines.add("        p99.9 " + formatMicros(stats.latency.p999) + "  max " + formatMicros(stats.latency.max) + " ms");
+
+    text.clear();
+    auto textArea = bounds.toFloat().reduced(8.0f);
+    for (int i = 0; i < lines.size(); ++i)
+        text.addLineOfText(font, lines[i], textArea.getX(), textArea.getY() + textHeight * static_cast<float>(i + 1));
+
+    rebuildGraph();
+
+    lastRefreshMs = nowMs;
+    lastNotesIngested = stats.notesIngested;
+    framesSinceRefresh = paintsSinceRefresh = 0;
+    paintMsTotal = paintMsMax = 0.0;
+}
+
+void PerformanceHud::rebuildGraph()
+{
+    graph.clear();
+
+    auto step = graphBounds.getWidth() / static_cast<float>(numFrameSamples - 1);
+    for (int i = 0; i < numFrameSamples; ++i)
+    {
+        // Oldest sample on the left
+        auto frameMs = frameTimesMs[static_cast<size_t>((nextFrameSample + i) % numFrameSamples)];
+        auto x = graphBounds.getX() + step * static_cast<float>(i);
+        auto y = graphBounds.getBottom() - graphBounds.getHeight() * juce::jmin(frameMs, graphCeilingMs) / graphCeilingMs;
+
+        if (i == 0)
+            graph.startNewSubPath(x, y);
+        else
+            graph.lineTo(x, y);
+    }
+}
+
+//==============================================================================
+void PerformanceHud::draw(juce::Graphics& g)
+{
+    auto startTicks = juce::Time::getHighResolutionTicks();
+
+    g.setColour(juce::Colours::black.withAlpha(0.7f));
+    g.fillRect(bounds);
+
+    // 60 Hz budget line
+    auto budgetY = graphBounds.getBottom() - graphBounds.getHeight() * (1000.0f / 60.0f) / graphCeilingMs;
+    g.setColour(juce::Colours::darkgrey);
+    g.drawLine(graphBounds.getX(), budgetY, graphBounds.getRight(), budgetY);
+
+    g.setColour(juce::Colours::limegreen);
+    g.strokePath(graph, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::white);
+    text.draw(g);
+
+    lastDrawMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+}
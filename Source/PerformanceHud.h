@@ -0,0 +1,71 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "LatencyHistogram.h"
+#include <array>
+
+//==============================================================================
+// Diagnostics overlay drawn by MainComponent over the notes and its child
+// controls. Timing samples are collected every frame into fixed arrays; the text
+// and frame-time graph are only rebuilt a few times a second, so drawing the HUD
+// is a rectangle fill, a cached GlyphArrangement and one stroked Path.
+class PerformanceHud
+{
+public:
+    // Counters sampled from the pipeline at each refresh. Totals are cumulative;
+    // the HUD turns them into rates itself.
+    struct Stats
+    {
+        int liveNotes = 0;
+        int noteCapacity = 0;
+        juce::uint64 notesIngested = 0;
+        int peakQueueDepth = 0;     // events waiting in the fullest input queue at a drain
+        juce::uint64 queueDrops = 0;
+        juce::uint64 poolDrops = 0;
+        LatencyHistogram::Summary latency;
+    };
+
+    static constexpr int numFrameSamples = 120;
+    static constexpr double refreshIntervalMs = 250.0;
+
+    PerformanceHud();
+
+    void setVisible(bool shouldBeVisible) noexcept;
+    bool isVisible() const noexcept { return visible; }
+
+    juce::Rectangle<int> getBounds() const noexcept { return bounds; }
+
+    // Frame loop, every vblank while visible
+    void frameStarted(double nowMs) noexcept;
+    bool isRefreshDue(double nowMs) const noexcept { return nowMs - lastRefreshMs >= refreshIntervalMs; }
+    void refresh(const Stats& stats, double nowMs);
+
+    // paint() reports what the notes cost; paintOverChildren() draws the cached overlay
+    void paintFinished(double paintMs) noexcept;
+    void draw(juce::Graphics& g);
+
+private:
+    void rebuildGraph();
+
+    bool visible = false;
+    juce::Rectangle<int> bounds { 10, 10, 280, 196 };
+    juce::Rectangle<float> graphBounds;
+
+    // Written every frame
+    std::array<float, numFrameSamples> frameTimesMs {};
+    int nextFrameSample = 0;
+    double lastFrameMs = 0.0;
+    int framesSinceRefresh = 0;
+    double paintMsTotal = 0.0, paintMsMax = 0.0;
+    int paintsSinceRefresh = 0;
+    double lastDrawMs = 0.0;
+
+    // Rebuilt on refresh
+    double lastRefreshMs = 0.0;
+    juce::uint64 lastNotesIngested = 0;
+    juce::GlyphArrangement text;
+    juce::Path graph;
+    juce::Font font;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformanceHud)
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FadeEngine.h"
+
+//==============================================================================
+// Everything the ingestion and render steps need from the settings UI. Edited
+// on the message thread as a copy and published whole through a
+// SnapshotPublisher; readers on any thread see one consistent version.
+struct RenderSettings
+{
+    juce::uint32 version = 1;
+
+    float fadeRate = 5.0f;          // percent per 1/60 s, see FadeEngine::setFadeRate()
+    bool fadeEnabled = true;
+    FadeEngine::Shape fadeShape = FadeEngine::Shape::exponential;
+
+    juce::Colour noteColour = juce::Colours::white;
+    bool instantColourUpdate = false;
+
+    float getEffectiveFadeRate() const noexcept { return fadeEnabled ? fadeRate : 0.0f; }
+};
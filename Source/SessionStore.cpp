@@ -0,0 +1,110 @@
+#include "SessionStore.h"
+
+//==============================================================================
+namespace
+{
+    const juce::String sessionKey("session");
+
+    juce::PropertiesFile::Options getSettingsFileOptions()
+    {
+        juce::PropertiesFile::Options options;
+        options.applicationName = "iLumidi";
+        options.filenameSuffix = "settings";
+        options.folderName = "iLumidi";
+        options.osxLibrarySubFolder = "Application Support";
+        options.storageFormat = juce::PropertiesFile::storeAsXML;
+        options.millisecondsBeforeSaving = -1; // only ever saved from the writer thread
+        return options;
+    }
+}
+
+//==============================================================================
+SessionStore::SessionStore(std::function<juce::ValueTree()> createSessionState)
+    : juce::Thread("iLumidi session writer"),
+      createState(std::move(createSessionState)),
+      properties(getSettingsFileOptions())
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+SessionStore::~SessionStore()
+{
+    // The writer drains anything handed over before exiting
+    flush();
+
+    signalThreadShouldExit();
+    notify();
+    stopThread(4000);
+}
+
+//==============================================================================
+juce::ValueTree SessionStore::load() const
+{
+    if (auto xml = properties.getXmlValue(sessionKey))
+    {
+        auto session = juce::ValueTree::fromXml(*xml);
+        if (session.hasType(SessionIds::session))
+            return session;
+    }
+
+    return {};
+}
+
+void SessionStore::saveSoon()
+{
+    startTimer(saveDelayMs);
+}
+
+void SessionStore::flush()
+{
+    if (isTimerRunning())
+        timerCallback();
+}
+
+void SessionStore::timerCallback()
+{
+    stopTimer();
+
+    auto session = createState();
+    if (!session.isValid())
+        return;
+
+    auto xml = session.createXml();
+
+    {
+        const juce::ScopedLock sl(pendingLock);
+        pendingXml = std::move(xml);
+    }
+
+    notify();
+}
+
+//==============================================================================
+void SessionStore::run()
+{
+    for (;;)
+    {
+        std::unique_ptr<juce::XmlElement> xml;
+
+        {
+            const juce::ScopedLock sl(pendingLock);
+            xml = std::move(pendingXml);
+        }
+
+        if (xml == nullptr)
+        {
+            if (threadShouldExit())
+                return;
+
+            wait(-1);
+            continue;
+        }
+
+        properties.setValue(sessionKey, xml.get());
+
+        if (!properties.saveIfNeeded())
+        {
+            DBG("Couldn't save the session to " + properties.getFile().getFullPathName());
+        }
+    }
+}
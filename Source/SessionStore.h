@@ -0,0 +1,63 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+// Property and type names of the session ValueTree:
+//
+//   <Session fadeRate fadeEnabled fadeShape noteColour instantColourUpdate>
+//     <Device identifier name selected channelMask/>
+//     ...
+//   </Session>
+namespace SessionIds
+{
+    inline const juce::Identifier session             { "Session" };
+    inline const juce::Identifier device              { "Device" };
+    inline const juce::Identifier identifier          { "identifier" };
+    inline const juce::Identifier name                { "name" };
+    inline const juce::Identifier selected            { "selected" };
+    inline const juce::Identifier channelMask         { "channelMask" };
+    inline const juce::Identifier fadeRate            { "fadeRate" };
+    inline const juce::Identifier fadeEnabled         { "fadeEnabled" };
+    inline const juce::Identifier fadeShape           { "fadeShape" };
+    inline const juce::Identifier noteColour          { "noteColour" };
+    inline const juce::Identifier instantColourUpdate { "instantColourUpdate" };
+}
+
+//==============================================================================
+// Keeps the last session in the user's settings file. saveSoon() only starts a
+// timer; once changes have been quiet for saveDelayMs the owner's tree is built
+// once, serialised and written on a background thread, so neither a burst of
+// clicks nor a slow disk costs the message thread anything per change. flush()
+// hands over a pending save straight away; the writer finishes it before the
+// store is destroyed.
+class SessionStore : private juce::Thread,
+                     private juce::Timer
+{
+public:
+    static constexpr int saveDelayMs = 1000;
+
+    explicit SessionStore(std::function<juce::ValueTree()> createSessionState);
+    ~SessionStore() override;
+
+    // The saved session, or an invalid tree if there isn't one. Message thread.
+    juce::ValueTree load() const;
+
+    // Debounced; message thread
+    void saveSoon();
+    void flush();
+
+private:
+    void timerCallback() override;
+    void run() override;
+
+    std::function<juce::ValueTree()> createState;
+    juce::PropertiesFile properties;
+
+    juce::CriticalSection pendingLock;
+    std::unique_ptr<juce::XmlElement> pendingXml;   // handed to the writer thread
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SessionStore)
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Publishes immutable snapshots from the message thread to realtime readers.
+// Readers do a single atomic pointer load and never lock or allocate. Replaced
+// snapshots are kept alive for a grace period before being deleted, which is far
+// longer than any reader holds on to a pointer (one MIDI callback or one frame).
+template <typename Snapshot>
+class SnapshotPublisher
+{
+public:
+    static constexpr juce::uint32 retireGracePeriodMs = 500;
+
+    SnapshotPublisher() : live(std::make_unique<Snapshot>())
+    {
+        current.store(live.get(), std::memory_order_release);
+    }
+
+    // Any thread
+    const Snapshot* read() const noexcept { return current.load(std::memory_order_acquire); }
+
+    // Message thread only
+    void publish(std::unique_ptr<Snapshot> next)
+    {
+        jassert(next != nullptr);
+
+        auto now = juce::Time::getMillisecondCounter();
+        current.store(next.get(), std::memory_order_release);
+        retired.push_back({ std::move(live), now });
+        live = std::move(next);
+
+        std::erase_if(retired, [now](const auto& r) { return now - r.retiredAt > retireGracePeriodMs; });
+    }
+
+private:
+    struct Retired
+    {
+        std::unique_ptr<Snapshot> snapshot;
+        juce::uint32 retiredAt;
+    };
+
+    std::atomic<const Snapshot*> current { nullptr };
+    std::unique_ptr<Snapshot> live;
+    std::vector<Retired> retired;
+
+    JUCE_DECLARE_NON_COPYABLE(SnapshotPublisher)
+};
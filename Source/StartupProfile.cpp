@@ -0,0 +1,74 @@
+#include "StartupProfile.h"
+#include <array>
+
+//==============================================================================
+namespace
+{
+    constexpr auto numMilestones = static_cast<size_t>(StartupProfile::Milestone::numMilestones);
+
+    std::array<double, numMilestones> markedAt {};  // millisecond counter; 0 = not reached
+    bool reported = false;
+}
+
+//==============================================================================
+void StartupProfile::mark(Milestone milestone)
+{
+    auto& time = markedAt[static_cast<size_t>(milestone)];
+    if (time != 0.0)
+        return;
+
+    time = juce::Time::getMillisecondCounterHiRes();
+
+    if (!reported && has(Milestone::firstPaint) && has(Milestone::midiReady))
+    {
+        reported = true;
+        juce::Logger::writeToLog(getSummary());
+    }
+}
+
+bool StartupProfile::has(Milestone milestone) noexcept
+{
+    return markedAt[static_cast<size_t>(milestone)] != 0.0;
+}
+
+double StartupProfile::getMs(Milestone milestone) noexcept
+{
+    if (!has(milestone) || !has(Milestone::initialise))
+        return -1.0;
+
+    return markedAt[static_cast<size_t>(milestone)] - markedAt[static_cast<size_t>(Milestone::initialise)];
+}
+
+//==============================================================================
+const char* StartupProfile::getMilestoneName(Milestone milestone) noexcept
+{
+    switch (milestone)
+    {
+        case Milestone::initialise:         return "initialise";
+        case Milestone::windowVisible:      return "window visible";
+        case Milestone::firstPaint:         return "first paint";
+        case Milestone::devicesEnumerated:  return "devices enumerated";
+        case Milestone::midiReady:          return "MIDI ready";
+        case Milestone::numMilestones:      break;
+    }
+
+    return "?";
+}
+
+juce::String StartupProfile::getSummary()
+{
+    juce::String summary("Startup:");
+
+    for (size_t i = 1; i < numMilestones; ++i)
+    {
+        auto ms = getMs(static_cast<Milestone>(i));
+        summary << (i > 1 ? ", " : " ") << getMilestoneName(static_cast<Milestone>(i)) << " "
+                << (ms >= 0.0 ? juce::String(ms, 1) + " ms" : juce::String("-"));
+    }
+
+    auto liveMs = juce::jmax(getMs(Milestone::firstPaint), getMs(Milestone::midiReady));
+    summary << (liveMs > budgetMs ? " -- OVER the " : " (budget ") << juce::String(budgetMs, 0) << " ms"
+            << (liveMs > budgetMs ? " budget" : ")");
+
+    return summary;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Cold start timeline, measured from the start of iLumidiApplication::initialise.
+// Each milestone keeps the first time it's marked. Once the canvas has painted
+// and MIDI is ready, the breakdown is written to the log once and checked
+// against the startup budget. Message thread only.
+class StartupProfile
+{
+public:
+    enum class Milestone
+    {
+        initialise,         // JUCEApplication::initialise entered
+        windowVisible,      // main window created and shown
+        firstPaint,         // first frame of the canvas painted
+        devicesEnumerated,  // first MIDI device list delivered
+        midiReady,          // every selected device open and started
+        numMilestones
+    };
+
+    static constexpr double budgetMs = 1000.0;
+
+    static void mark(Milestone milestone);
+    static bool has(Milestone milestone) noexcept;
+
+    // Milliseconds since 'initialise', or -1 if not reached yet
+    static double getMs(Milestone milestone) noexcept;
+
+    static juce::String getSummary();
+    static const char* getMilestoneName(Milestone milestone) noexcept;
+};
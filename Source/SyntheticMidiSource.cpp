@@ -0,0 +1,175 @@
+#include "SyntheticMidiSource.h"
+#include <algorithm>
+
+//==============================================================================
+namespace
+{
+    constexpr int lowestPianoKey = 21, highestPianoKey = 108;
+
+    juce::uint8 randomVelocity(juce::Random& random)
+    {
+        return static_cast<juce::uint8>(random.nextInt(127) + 1);
+    }
+}
+
+//==============================================================================
+SyntheticMidiGenerator::SyntheticMidiGenerator(const Settings& settingsToUse)
+    : settings(settingsToUse)
+{
+    settings.eventsPerSecond = juce::jmax(1.0, settings.eventsPerSecond);
+    settings.numDevices = juce::jlimit(1, maxDevices, settings.numDevices);
+    reset();
+}
+
+void SyntheticMidiGenerator::reset()
+{
+    random.setSeed(settings.seed);
+    numSteps = 0;
+    numPending = 0;
+    gestureTime = 0.0;
+    gestureDevice = 0;
+    glissandoKey = lowestPianoKey;
+    glissandoDirection = 1;
+}
+
+//==============================================================================
+void SyntheticMidiGenerator::addToGesture(const juce::MidiMessage& message) noexcept
+{
+    if (numPending < static_cast<int>(pending.size()))
+        pending[static_cast<size_t>(numPending++)] = message;
+}
+
+void SyntheticMidiGenerator::generateGesture(double time)
+{
+    gestureTime = time;
+    gestureDevice = settings.numDevices > 1 ? random.nextInt(settings.numDevices) : 0;
+
+    auto channel = random.nextInt(16) + 1;
+
+    switch (settings.pattern)
+    {
+        case Pattern::randomNotes:
+            addToGesture(juce::MidiMessage::noteOn(channel, random.nextInt(128), randomVelocity(random)));
+            break;
+
+        case Pattern::chordClusters:
+        {
+            auto root = lowestPianoKey + random.nextInt(highestPianoKey - lowestPianoKey - 12);
+            auto numNotes = 3 + random.nextInt(4);
+            auto velocity = randomVelocity(random);
+
+            for (int i = 0; i < numNotes; ++i)
+                addToGesture(juce::MidiMessage::noteOn(channel, root + random.nextInt(12), velocity));
+            break;
+        }
+
+        case Pattern::glissando:
+            addToGesture(juce::MidiMessage::noteOn(1, glissandoKey, static_cast<juce::uint8>(96)));
+
+            if (glissandoKey + glissandoDirection < lowestPianoKey || glissandoKey + glissandoDirection > highestPianoKey)
+                glissandoDirection = -glissandoDirection;
+
+            glissandoKey += glissandoDirection;
+            break;
+
+        case Pattern::blackMidiFlood:
+        {
+            auto key = random.nextInt(128);
+            addToGesture(juce::MidiMessage::noteOn(channel, key, randomVelocity(random)));
+            addToGesture(juce::MidiMessage::noteOff(channel, key));
+            break;
+        }
+
+        case Pattern::ccStorm:
+            addToGesture(juce::MidiMessage::controllerEvent(channel, random.nextInt(120), random.nextInt(128)));
+            break;
+
+        case Pattern::sysExBursts:
+        {
+            // Universal non-realtime, device 0x7f; contents are just noise
+            std::array<juce::uint8, 256> data {};
+            auto size = 32 + random.nextInt(256 - 32 + 1);
+            data[0] = 0x7e;
+            data[1] = 0x7f;
+
+            for (int i = 2; i < size; ++i)
+                data[static_cast<size_t>(i)] = static_cast<juce::uint8>(random.nextInt(128));
+
+            addToGesture(juce::MidiMessage::createSysExMessage(data.data(), size));
+            break;
+        }
+    }
+
+    std::reverse(pending.begin(), pending.begin() + numPending);
+}
+
+//==============================================================================
+juce::String SyntheticMidiGenerator::getPatternName(Pattern pattern)
+{
+    switch (pattern)
+    {
+        case Pattern::randomNotes:      return "random";
+        case Pattern::chordClusters:    return "chords";
+        case Pattern::glissando:        return "glissando";
+        case Pattern::blackMidiFlood:   return "black-midi";
+        case Pattern::ccStorm:          return "cc-storm";
+        case Pattern::sysExBursts:      return "sysex";
+    }
+
+    return {};
+}
+
+SyntheticMidiGenerator::Pattern SyntheticMidiGenerator::getPatternFromName(const juce::String& name, Pattern fallback)
+{
+    for (auto pattern : getAllPatterns())
+        if (getPatternName(pattern) == name)
+            return pattern;
+
+    return fallback;
+}
+
+juce::Array<SyntheticMidiGenerator::Pattern> SyntheticMidiGenerator::getAllPatterns()
+{
+    return { Pattern::randomNotes, Pattern::chordClusters, Pattern::glissando,
+             Pattern::blackMidiFlood, Pattern::ccStorm, Pattern::sysExBursts };
+}
+
+double SyntheticMidiGenerator::getDefaultRate(Pattern pattern)
+{
+    switch (pattern)
+    {
+        case Pattern::randomNotes:      return 1000.0;
+        case Pattern::chordClusters:    return 2000.0;
+        case Pattern::glissando:        return 500.0;
+        case Pattern::blackMidiFlood:   return 100000.0;
+        case Pattern::ccStorm:          return 20000.0;
+        case Pattern::sysExBursts:      return 200.0;
+    }
+
+    return 1000.0;
+}
+
+//==============================================================================
+SyntheticMidiPlayer::SyntheticMidiPlayer(const SyntheticMidiGenerator::Settings& settings, Sink sinkToUse)
+    : juce::Thread("iLumidi synthetic MIDI"), generator(settings), sink(std::move(sinkToUse))
+{
+    startThread(juce::Thread::Priority::high);
+}
+
+SyntheticMidiPlayer::~SyntheticMidiPlayer()
+{
+    stopThread(1000);
+}
+
+void SyntheticMidiPlayer::run()
+{
+    // Same clock as juce::MidiInput timestamps, so latency measurements still hold
+    auto originSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+
+    while (!threadShouldExit())
+    {
+        auto elapsedSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001 - originSeconds;
+        generator.generateUntil(elapsedSeconds, originSeconds, sink);
+        wait(1);
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <functional>
+
+//==============================================================================
+// Deterministic synthetic MIDI for stress and soak tests. Messages are spaced
+// exactly 1/eventsPerSecond apart on a virtual clock and their content comes from
+// a seeded juce::Random, so the same settings always produce the same stream no
+// matter how often generateUntil() is called. Used directly by the benchmark, and
+// through SyntheticMidiPlayer by the app.
+class SyntheticMidiGenerator
+{
+public:
+    enum class Pattern
+    {
+        randomNotes,        // single notes, random key, velocity and channel
+        chordClusters,      // 3-6 note clusters around a random root, sharing a timestamp
+        glissando,          // key-by-key runs that bounce between the ends of the keyboard
+        blackMidiFlood,     // note-on/note-off pairs across the whole range, meant for 100k+/s
+        ccStorm,            // controller changes on every channel
+        sysExBursts         // 32-256 byte SysEx messages
+    };
+
+    struct Settings
+    {
+        Pattern pattern = Pattern::randomNotes;
+        double eventsPerSecond = 1000.0;
+        int numDevices = 1;         // messages are interleaved across this many virtual devices
+        juce::int64 seed = 1;
+    };
+
+    static constexpr int maxDevices = 16;
+
+    explicit SyntheticMidiGenerator(const Settings& settingsToUse);
+
+    const Settings& getSettings() const noexcept { return settings; }
+
+    // Emits every message due up to 'elapsedSeconds' after the stream started, as
+    // callback(int device, const juce::MidiMessage&). Timestamps are originSeconds
+    // plus the message's time on the virtual clock. Returns the number emitted.
+    template <typename Callback>
+    int generateUntil(double elapsedSeconds, double originSeconds, Callback&& callback)
+    {
+        int numEmitted = 0;
+
+        while (getTimeOfStep(numSteps) <= elapsedSeconds)
+        {
+            if (numPending == 0)
+                generateGesture(getTimeOfStep(numSteps));
+
+            auto& message = pending[static_cast<size_t>(--numPending)];
+            message.setTimeStamp(originSeconds + gestureTime);
+            callback(gestureDevice, message);
+
+            ++numSteps;
+            ++numEmitted;
+        }
+
+        return numEmitted;
+    }
+
+    // Back to the first message of the stream
+    void reset();
+
+    juce::uint64 getNumGenerated() const noexcept { return numSteps; }
+
+    static juce::String getPatternName(Pattern pattern);
+    static Pattern getPatternFromName(const juce::String& name, Pattern fallback = Pattern::randomNotes);
+    static juce::Array<Pattern> getAllPatterns();
+
+    // A rate that shows the pattern off without being unreasonable on a laptop
+    static double getDefaultRate(Pattern pattern);
+
+private:
+    double getTimeOfStep(juce::uint64 step) const noexcept { return static_cast<double>(step) / settings.eventsPerSecond; }
+
+    void generateGesture(double time);
+    void addToGesture(const juce::MidiMessage& message) noexcept;
+
+    Settings settings;
+    juce::Random random;
+    juce::uint64 numSteps = 0;
+
+    // One gesture (a chord, a note-on/off pair) is generated at a time, all on one
+    // device and sharing one timestamp. It's stored reversed and handed out from the back.
+    std::array<juce::MidiMessage, 8> pending;
+    int numPending = 0;
+    double gestureTime = 0.0;
+    int gestureDevice = 0;
+
+    int glissandoKey = 21, glissandoDirection = 1;
+};
+
+//==============================================================================
+// Plays a SyntheticMidiGenerator in real time on its own thread, standing in for
+// a MIDI input callback. sink(device, message) is called on that thread.
+class SyntheticMidiPlayer : private juce::Thread
+{
+public:
+    using Sink = std::function<void(int device, const juce::MidiMessage& message)>;
+
+    SyntheticMidiPlayer(const SyntheticMidiGenerator::Settings& settings, Sink sinkToUse);
+    ~SyntheticMidiPlayer() override;
+
+    const SyntheticMidiGenerator::Settings& getSettings() const noexcept { return generator.getSettings(); }
+
+private:
+    void run() override;
+
+    SyntheticMidiGenerator generator;
+    Sink sink;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SyntheticMidiPlayer)
+};
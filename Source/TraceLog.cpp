@@ -0,0 +1,202 @@
+#include "TraceLog.h"
+#include "ChromeTraceWriter.h"
+#include <vector>
+
+//==============================================================================
+namespace
+{
+    // Index into TraceLog::rings, claimed the first time a thread records something
+    thread_local int traceThreadIndex = -1;
+
+    constexpr char fileMagic[4] = { 'I', 'L', 'T', 'R' };
+    constexpr juce::uint32 fileVersion = 1;
+}
+
+//==============================================================================
+struct TraceLog::Ring
+{
+    Ring() : fifo(recordsPerThread), records(static_cast<size_t>(recordsPerThread)) {}
+
+    juce::AbstractFifo fifo;
+    std::vector<Record> records;
+};
+
+//==============================================================================
+class TraceLog::Writer : public juce::Thread
+{
+public:
+    Writer(TraceLog& ownerToUse, std::unique_ptr<juce::FileOutputStream> streamToUse, Format format)
+        : juce::Thread("iLumidi trace writer"), owner(ownerToUse), stream(std::move(streamToUse))
+    {
+        auto ticksPerSecond = juce::Time::getHighResolutionTicksPerSecond();
+
+        if (format == Format::chromeJson)
+        {
+            chromeTrace = std::make_unique<ChromeTraceWriter>(*stream, ticksPerSecond, juce::Time::getHighResolutionTicks());
+            chromeTrace->writeHeader();
+        }
+        else
+        {
+            auto recordSize = static_cast<juce::uint32>(sizeof(Record));
+            stream->write(fileMagic, sizeof(fileMagic));
+            stream->write(&fileVersion, sizeof(fileVersion));
+            stream->write(&recordSize, sizeof(recordSize));
+            stream->write(&ticksPerSecond, sizeof(ticksPerSecond));
+        }
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(20);
+            drain();
+        }
+
+        drain();
+
+        // Recording is off by now, so these are final
+        if (chromeTrace != nullptr)
+            chromeTrace->writeFooter(owner.getNumWritten(), owner.getNumDropped());
+
+        stream->flush();
+    }
+
+private:
+    void drain()
+    {
+        owner.drain([this](const Record* records, int numRecords)
+        {
+            if (chromeTrace != nullptr)
+            {
+                for (int i = 0; i < numRecords; ++i)
+                    chromeTrace->write(records[i]);
+            }
+            else
+            {
+                stream->write(records, static_cast<size_t>(numRecords) * sizeof(Record));
+            }
+        });
+    }
+
+    TraceLog& owner;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    std::unique_ptr<ChromeTraceWriter> chromeTrace;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Writer)
+};
+
+//==============================================================================
+TraceLog& TraceLog::getInstance()
+{
+    static TraceLog instance;
+    return instance;
+}
+
+TraceLog::~TraceLog()
+{
+    stop();
+}
+
+bool TraceLog::start(const juce::File& file, Format format)
+{
+    stop();
+
+    // Rings are allocated once and kept for the life of the process, so a
+    // producer that registered earlier can never see one disappear.
+    for (auto& ring : rings)
+        if (ring == nullptr)
+            ring = std::make_unique<Ring>();
+
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+    {
+        DBG("Failed to open trace file: " + file.getFullPathName());
+        return false;
+    }
+
+    // Anything left over from a previous session belongs to a different file. Only
+    // the consumer side is touched; a late producer may still be finishing a write.
+    for (auto& ring : rings)
+        ring->fifo.read(ring->fifo.getNumReady());
+
+    numDropped.store(0, std::memory_order_relaxed);
+    numWritten.store(0, std::memory_order_relaxed);
+
+    writer = std::make_unique<Writer>(*this, std::move(stream), format);
+    enabled.store(true, std::memory_order_release);
+    writer->startThread();
+
+    DBG("Tracing to " + file.getFullPathName());
+    return true;
+}
+
+void TraceLog::stop()
+{
+    enabled.store(false, std::memory_order_release);
+
+    if (writer != nullptr)
+    {
+        writer->stopThread(2000);
+        writer.reset();
+
+        DBG("Trace finished: " + juce::String(getNumWritten()) + " records written, " + juce::String(getNumDropped()) + " dropped");
+    }
+}
+
+//==============================================================================
+TraceLog::Ring* TraceLog::getRingForThisThread() noexcept
+{
+    if (traceThreadIndex < 0)
+        traceThreadIndex = juce::jmin(numThreadsRegistered.fetch_add(1, std::memory_order_relaxed), maxThreads);
+
+    return traceThreadIndex < maxThreads ? rings[static_cast<size_t>(traceThreadIndex)].get() : nullptr;
+}
+
+void TraceLog::write(EventType type, juce::uint64 id, juce::uint32 value, juce::uint16 slot) noexcept
+{
+    auto* ring = getRingForThisThread();
+    if (ring == nullptr)
+    {
+        numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto scope = ring->fifo.write(1);
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+    {
+        numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& record = ring->records[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+    record.ticks = juce::Time::getHighResolutionTicks();
+    record.id = id;
+    record.value = value;
+    record.slot = slot;
+    record.type = static_cast<juce::uint8>(type);
+    record.thread = static_cast<juce::uint8>(traceThreadIndex);
+}
+
+template <typename Callback>
+void TraceLog::drain(Callback&& callback)
+{
+    auto numRings = juce::jmin(numThreadsRegistered.load(std::memory_order_relaxed), maxThreads);
+
+    for (int i = 0; i < numRings; ++i)
+    {
+        auto& ring = *rings[static_cast<size_t>(i)];
+        auto scope = ring.fifo.read(ring.fifo.getNumReady());
+
+        if (scope.blockSize1 > 0)
+            callback(&ring.records[static_cast<size_t>(scope.startIndex1)], scope.blockSize1);
+
+        if (scope.blockSize2 > 0)
+            callback(&ring.records[static_cast<size_t>(scope.startIndex2)], scope.blockSize2);
+
+        numWritten.fetch_add(static_cast<juce::uint64>(scope.blockSize1 + scope.blockSize2), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+// Lock-free binary event trace for the MIDI-to-frame pipeline. Each thread that
+// records gets its own preallocated single-producer ring on first use; a
+// background thread drains all rings to disk. Recording costs one atomic load
+// when tracing is off and a high-resolution tick read plus a ring write when on.
+// It never allocates or locks, so it is safe on the MIDI input thread.
+class TraceLog
+{
+public:
+    enum class EventType : juce::uint8
+    {
+        midiArrival,        // MIDI thread: value = raw bytes, slot = input slot (0xffff if unknown)
+        filterAccepted,     // MIDI thread: value = raw bytes
+        filterRejected,     // MIDI thread: value = raw bytes
+        enqueued,           // MIDI thread: id = note id
+        queueOverflow,      // MIDI thread: id = note id that was dropped
+        noteIngested,       // message thread: id = note id, value = note | velocity << 8
+        noteEvicted,        // message thread: value = number of notes evicted by the pool
+        noteRefused,        // message thread: id = note id the full pool refused
+        frameStart,         // message thread: value = live notes
+        frameEnd,           // message thread: value = live notes
+        midiCallbackEnd,    // MIDI thread: closes the callback opened by midiArrival
+        animationStart,     // message thread
+        animationEnd,       // message thread: value = live notes
+        drainStart,         // message thread
+        drainEnd,           // message thread: value = events drained
+        repaintRequested    // message thread: value = packRange(x, width), or fullRepaint
+    };
+
+    enum class Format
+    {
+        binary,             // raw Records after a small header, for offline tools
+        chromeJson          // Chrome Trace Event JSON, opens in Perfetto or chrome://tracing
+    };
+
+    static constexpr juce::uint32 fullRepaint = 0xffffffff;
+
+    struct Record
+    {
+        juce::int64 ticks;      // Time::getHighResolutionTicks()
+        juce::uint64 id;
+        juce::uint32 value;
+        juce::uint16 slot;
+        juce::uint8 type;
+        juce::uint8 thread;
+    };
+
+    static constexpr int maxThreads = 16;
+    static constexpr int recordsPerThread = 8192;
+
+    static TraceLog& getInstance();
+
+    // Message thread. Starts the writer thread and begins recording into file.
+    bool start(const juce::File& file, Format format = Format::binary);
+    void stop();
+
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_acquire); }
+
+    static void record(EventType type, juce::uint64 id = 0, juce::uint32 value = 0, juce::uint16 slot = 0) noexcept
+    {
+        auto& log = getInstance();
+        if (log.isEnabled())
+            log.write(type, id, value, slot);
+    }
+
+    // Identifies a note from its arrival on input 'slot' to the frame that shows it
+    static juce::uint64 makeNoteId(int slot, juce::uint64 sequence) noexcept
+    {
+        return (static_cast<juce::uint64>(slot) << 48) | (sequence & 0xffffffffffffull);
+    }
+
+    static juce::uint32 packRange(int start, int length) noexcept
+    {
+        return (static_cast<juce::uint32>(juce::jlimit(0, 0xffff, start)) << 16)
+             | static_cast<juce::uint32>(juce::jlimit(0, 0xffff, length));
+    }
+
+    static juce::uint32 packBytes(const juce::uint8* data, int size) noexcept
+    {
+        juce::uint32 packed = 0;
+        for (int i = 0; i < juce::jmin(size, 4); ++i)
+            packed |= static_cast<juce::uint32>(data[i]) << (8 * i);
+        return packed;
+    }
+
+    // Since the last start(): records lost to a full ring or to a thread past
+    // maxThreads, and records handed to the writer
+    juce::uint64 getNumDropped() const noexcept { return numDropped.load(std::memory_order_relaxed); }
+    juce::uint64 getNumWritten() const noexcept { return numWritten.load(std::memory_order_relaxed); }
+
+    ~TraceLog();
+
+private:
+    TraceLog() = default;
+
+    struct Ring;
+    class Writer;
+
+    void write(EventType type, juce::uint64 id, juce::uint32 value, juce::uint16 slot) noexcept;
+    Ring* getRingForThisThread() noexcept;
+    template <typename Callback>
+    void drain(Callback&& callback);
+
+    std::array<std::unique_ptr<Ring>, maxThreads> rings;
+    std::atomic<int> numThreadsRegistered { 0 };
+    std::atomic<bool> enabled { false };
+    std::atomic<juce::uint64> numDropped { 0 }, numWritten { 0 };
+    std::unique_ptr<Writer> writer;
+
+    JUCE_DECLARE_NON_COPYABLE(TraceLog)
+};